@@ -9,6 +9,7 @@
 #include "aigprop.h"
 #include "btorclone.h"
 #include "btorcore.h"
+#include "btorlsutils.h"
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btorstack.h"
@@ -48,22 +49,46 @@ msg (char *fmt, ...)
 
 /*------------------------------------------------------------------------*/
 
+static inline int32_t
+get_assignment_id (AIGProp *aprop, int32_t id)
+{
+  assert (aprop);
+  assert (aprop->model);
+  assert ((uint32_t) abs (id) < aprop->size);
+  assert (aprop->model[abs (id)]);
+  return id < 0 ? -aprop->model[-id] : aprop->model[id];
+}
+
+static inline double
+get_score_id (AIGProp *aprop, int32_t id)
+{
+  assert (aprop);
+  assert (aprop->score);
+  assert ((uint32_t) abs (id) < aprop->size);
+  return id < 0 ? aprop->score[2 * -id + 1] : aprop->score[2 * id];
+}
+
 int32_t
 aigprop_get_assignment_aig (AIGProp *aprop, BtorAIG *aig)
 {
   assert (aprop);
 
-  int32_t res;
-  int32_t id;
-
   if (btor_aig_is_true (aig)) return 1;
   if (btor_aig_is_false (aig)) return -1;
+  return get_assignment_id (aprop, btor_aig_get_id (aig));
+}
 
-  id = btor_aig_get_id (BTOR_REAL_ADDR_AIG (aig));
-  assert (btor_hashint_map_get (aprop->model, id));
-  res = btor_hashint_map_get (aprop->model, id)->as_int;
-  res = BTOR_IS_INVERTED_AIG (aig) ? -res : res;
-  return res;
+bool
+aigprop_has_assignment_aig (AIGProp *aprop, BtorAIG *aig)
+{
+  assert (aprop);
+
+  uint32_t id;
+
+  if (btor_aig_is_const (aig)) return true;
+  if (!aprop->model) return false;
+  id = BTOR_REAL_ADDR_AIG (aig)->id;
+  return id < aprop->size && aprop->model[id] != 0;
 }
 
 /*------------------------------------------------------------------------*/
@@ -75,198 +100,94 @@ aigprop_get_assignment_aig (AIGProp *aprop, BtorAIG *aig)
  * score (BTOR_CONST_AIG_FALSE, A) = 0.0
  * score (aig0 /\ aig1, A) = 1/2 * (score (aig0) + score (aig1), A)
  * score (-(-aig0 /\ -aig1), A) = max (score (-aig0), score (-aig1), A)
+ *
+ * Note: the children of an AIG AND are never constant.
  */
 
 #define AIGPROP_LOG_COMPUTE_SCORE_AIG(cur, left, right, s0, s1, res) \
   do                                                                 \
   {                                                                  \
-    a = aigprop_get_assignment_aig (aprop, left);                    \
-    assert (a);                                                      \
     AIGPROPLOG (3,                                                   \
                 "        assignment aig0 (%s%d): %d",                \
-                BTOR_IS_INVERTED_AIG (left) ? "-" : "",              \
-                BTOR_REAL_ADDR_AIG (left)->id,                       \
-                a < 0 ? 0 : 1);                                      \
-    a = aigprop_get_assignment_aig (aprop, right);                   \
-    assert (a);                                                      \
+                (left) < 0 ? "-" : "",                               \
+                abs (left),                                          \
+                get_assignment_id (aprop, left) < 0 ? 0 : 1);        \
     AIGPROPLOG (3,                                                   \
                 "        assignment aig1 (%s%d): %d",                \
-                BTOR_IS_INVERTED_AIG (right) ? "-" : "",             \
-                BTOR_REAL_ADDR_AIG (right)->id,                      \
-                a < 0 ? 0 : 1);                                      \
+                (right) < 0 ? "-" : "",                              \
+                abs (right),                                         \
+                get_assignment_id (aprop, right) < 0 ? 0 : 1);       \
     AIGPROPLOG (3,                                                   \
                 "        score      aig0 (%s%d): %f%s",              \
-                BTOR_IS_INVERTED_AIG (left) ? "-" : "",              \
-                BTOR_REAL_ADDR_AIG (left)->id,                       \
+                (left) < 0 ? "-" : "",                               \
+                abs (left),                                          \
                 s0,                                                  \
                 s0 < 1.0 ? " (< 1.0)" : "");                         \
     AIGPROPLOG (3,                                                   \
                 "        score      aig1 (%s%d): %f%s",              \
-                BTOR_IS_INVERTED_AIG (right) ? "-" : "",             \
-                BTOR_REAL_ADDR_AIG (right)->id,                      \
+                (right) < 0 ? "-" : "",                              \
+                abs (right),                                         \
                 s1,                                                  \
                 s1 < 1.0 ? " (< 1.0)" : "");                         \
     AIGPROPLOG (3,                                                   \
                 "      * score cur (%s%d): %f%s",                    \
-                BTOR_IS_INVERTED_AIG (cur) ? "-" : "",               \
-                real_cur->id,                                        \
+                (cur) < 0 ? "-" : "",                                \
+                abs (cur),                                           \
                 res,                                                 \
                 res < 1.0 ? " (< 1.0)" : "");                        \
   } while (0)
 
-static double
-compute_score_aig (AIGProp *aprop, BtorAIG *aig)
+static inline void
+compute_score_var (AIGProp *aprop, int32_t id)
 {
   assert (aprop);
-  assert (!btor_aig_is_const (aig));
-
-  int32_t curid, leftid, rightid;
-  double res, sleft, sright;
-  BtorAIGPtrStack stack;
-  BtorAIG *cur, *real_cur, *left, *right;
-  BtorIntHashTable *mark;
-  BtorHashTableData *d;
-  BtorMemMgr *mm;
-#ifndef NDEBUG
-  int32_t a;
-#endif
+  assert (id > 0);
+  assert (btor_aig_is_var (btor_aig_get_by_id (aprop->amgr, id)));
 
-  curid = btor_aig_get_id (aig);
-  if (btor_hashint_map_contains (aprop->score, curid))
-    return btor_hashint_map_get (aprop->score, curid)->as_dbl;
-
-  mm  = aprop->amgr->btor->mm;
-  res = 0.0;
+  double res;
 
-  BTOR_INIT_STACK (mm, stack);
-  mark = btor_hashint_map_new (mm);
-
-  BTOR_PUSH_STACK (stack, aig);
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur      = BTOR_POP_STACK (stack);
-    real_cur = BTOR_REAL_ADDR_AIG (cur);
-
-    if (btor_aig_is_const (real_cur)) continue;
+  res                      = get_assignment_id (aprop, id) < 0 ? 0.0 : 1.0;
+  aprop->score[2 * id]     = res;
+  aprop->score[2 * id + 1] = res == 0.0 ? 1.0 : 0.0;
+  AIGPROPLOG (3, "        * score cur (%d): %f", id, res);
+  AIGPROPLOG (3, "        * score cur (-%d): %f", id, 1.0 - res);
+}
 
-    curid = btor_aig_get_id (cur);
-    if (btor_hashint_map_contains (aprop->score, curid)) continue;
+static inline void
+compute_score_and (AIGProp *aprop, BtorAIG *aig)
+{
+  assert (aprop);
+  assert (BTOR_IS_REGULAR_AIG (aig));
+  assert (btor_aig_is_and (aig));
 
-    d = btor_hashint_map_get (mark, real_cur->id);
-    if (d && d->as_int == 1) continue;
+  int32_t id, left, right;
+  double res, sleft, sright;
 
-    if (!d)
-    {
-      btor_hashint_map_add (mark, real_cur->id);
-      assert (btor_aig_is_var (real_cur) || btor_aig_is_and (real_cur));
-      BTOR_PUSH_STACK (stack, cur);
-      if (btor_aig_is_and (real_cur))
-      {
-        left  = btor_aig_get_left_child (aprop->amgr, real_cur);
-        right = btor_aig_get_right_child (aprop->amgr, real_cur);
-        if (!btor_aig_is_const (left)) BTOR_PUSH_STACK (stack, left);
-        if (!btor_aig_is_const (right)) BTOR_PUSH_STACK (stack, right);
-      }
-    }
-    else
-    {
-      assert (d->as_int == 0);
-      d->as_int = 1;
-      assert (aigprop_get_assignment_aig (aprop, cur) != 0);
+  id    = aig->id;
+  left  = aig->children[0];
+  right = aig->children[1];
+
+  sleft  = get_score_id (aprop, left);
+  sright = get_score_id (aprop, right);
+  res    = (sleft + sright) / 2.0;
+  /* fix rounding errors (eg. (0.999+1.0)/2 = 1.0) ->
+     choose minimum (else it might again result in 1.0) */
+  if (res == 1.0 && (sleft < 1.0 || sright < 1.0))
+    res = sleft < sright ? sleft : sright;
+  assert (res >= 0.0 && res <= 1.0);
+  aprop->score[2 * id] = res;
 #ifndef NDEBUG
-      a = aigprop_get_assignment_aig (aprop, cur);
-      assert (a);
-      AIGPROPLOG (3, "");
-      AIGPROPLOG (3,
-                  "  ** assignment cur (%s%d): %d",
-                  BTOR_IS_INVERTED_AIG (cur) ? "-" : "",
-                  real_cur->id,
-                  a < 0 ? 0 : 1);
+  AIGPROP_LOG_COMPUTE_SCORE_AIG (id, left, right, sleft, sright, res);
 #endif
-      assert (!btor_hashint_map_contains (aprop->score, curid));
-      assert (!btor_hashint_map_contains (aprop->score, -curid));
 
-      if (btor_aig_is_var (real_cur))
-      {
-        res = aigprop_get_assignment_aig (aprop, cur) < 0 ? 0.0 : 1.0;
-        AIGPROPLOG (3,
-                    "        * score cur (%s%d): %f",
-                    BTOR_IS_INVERTED_AIG (cur) ? "-" : "",
-                    real_cur->id,
-                    res);
-        AIGPROPLOG (3,
-                    "        * score cur (%s%d): %f",
-                    BTOR_IS_INVERTED_AIG (cur) ? "" : "-",
-                    real_cur->id,
-                    res == 0.0 ? 1.0 : 0.0);
-        btor_hashint_map_add (aprop->score, curid)->as_dbl = res;
-        btor_hashint_map_add (aprop->score, -curid)->as_dbl =
-            res == 0.0 ? 1.0 : 0.0;
-      }
-      else
-      {
-        assert (btor_aig_is_and (real_cur));
-
-        left    = btor_aig_get_left_child (aprop->amgr, real_cur);
-        right   = btor_aig_get_right_child (aprop->amgr, real_cur);
-        leftid  = btor_aig_get_id (left);
-        rightid = btor_aig_get_id (right);
-
-        assert (btor_aig_is_const (left)
-                || btor_hashint_map_contains (aprop->score, leftid));
-        assert (btor_aig_is_const (right)
-                || btor_hashint_map_contains (aprop->score, rightid));
-        assert (btor_aig_is_const (left)
-                || btor_hashint_map_contains (aprop->score, -leftid));
-        assert (btor_aig_is_const (right)
-                || btor_hashint_map_contains (aprop->score, -rightid));
-
-        sleft = btor_aig_is_const (left)
-                    ? (btor_aig_is_true (left) ? 1.0 : 0.0)
-                    : btor_hashint_map_get (aprop->score, leftid)->as_dbl;
-        sright = btor_aig_is_const (right)
-                     ? (btor_aig_is_true (right) ? 1.0 : 0.0)
-                     : btor_hashint_map_get (aprop->score, rightid)->as_dbl;
-        res = (sleft + sright) / 2.0;
-        /* fix rounding errors (eg. (0.999+1.0)/2 = 1.0) ->
-           choose minimum (else it might again result in 1.0) */
-        if (res == 1.0 && (sleft < 1.0 || sright < 1.0))
-          res = sleft < sright ? sleft : sright;
-        assert (res >= 0.0 && res <= 1.0);
-        btor_hashint_map_add (aprop->score, real_cur->id)->as_dbl = res;
-#ifndef NDEBUG
-        AIGPROP_LOG_COMPUTE_SCORE_AIG (
-            real_cur, left, right, sleft, sright, res);
-#endif
-        sleft = btor_aig_is_const (left)
-                    ? (btor_aig_is_true (left) ? 0.0 : 1.0)
-                    : btor_hashint_map_get (aprop->score, -leftid)->as_dbl;
-        sright = btor_aig_is_const (right)
-                     ? (btor_aig_is_true (right) ? 0.0 : 1.0)
-                     : btor_hashint_map_get (aprop->score, -rightid)->as_dbl;
-        res = sleft > sright ? sleft : sright;
-        assert (res >= 0.0 && res <= 1.0);
-        btor_hashint_map_add (aprop->score, -real_cur->id)->as_dbl = res;
+  sleft  = get_score_id (aprop, -left);
+  sright = get_score_id (aprop, -right);
+  res    = sleft > sright ? sleft : sright;
+  assert (res >= 0.0 && res <= 1.0);
+  aprop->score[2 * id + 1] = res;
 #ifndef NDEBUG
-        AIGPROP_LOG_COMPUTE_SCORE_AIG (BTOR_INVERT_AIG (real_cur),
-                                       BTOR_INVERT_AIG (left),
-                                       BTOR_INVERT_AIG (right),
-                                       sleft,
-                                       sright,
-                                       res);
+  AIGPROP_LOG_COMPUTE_SCORE_AIG (-id, -left, -right, sleft, sright, res);
 #endif
-      }
-      assert (btor_hashint_map_contains (aprop->score, curid));
-      assert (btor_hashint_map_contains (aprop->score, -curid));
-    }
-  }
-
-  btor_hashint_map_delete (mark);
-  BTOR_RELEASE_STACK (stack);
-
-  assert (btor_hashint_map_contains (aprop->score, btor_aig_get_id (aig)));
-  assert (btor_hashint_map_contains (aprop->score, -btor_aig_get_id (aig)));
-  return res;
 }
 
 static void
@@ -276,137 +197,39 @@ compute_scores (AIGProp *aprop)
   assert (aprop->roots);
   assert (aprop->model);
 
-  BtorAIGPtrStack stack;
-  BtorIntHashTable *cache;
-  BtorAIG *cur, *real_cur, *left, *right;
-  BtorIntHashTableIterator it;
-  BtorMemMgr *mm;
+  uint32_t i;
+  int32_t id;
+  BtorAIG *aig;
 
   AIGPROPLOG (3, "*** compute scores");
 
-  mm = aprop->amgr->btor->mm;
-
-  BTOR_INIT_STACK (mm, stack);
-  cache = btor_hashint_table_new (mm);
+  if (!aprop->score)
+    BTOR_NEWN (aprop->amgr->btor->mm, aprop->score, 2 * aprop->size);
 
-  if (!aprop->score) aprop->score = btor_hashint_map_new (mm);
-
-  /* collect roots */
-  btor_iter_hashint_init (&it, aprop->roots);
-  while (btor_iter_hashint_has_next (&it))
-    BTOR_PUSH_STACK (
-        stack, btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it)));
-
-  /* compute scores */
-  while (!BTOR_EMPTY_STACK (stack))
+  for (i = 0; i < BTOR_COUNT_STACK (aprop->nodes); i++)
   {
-    cur      = BTOR_POP_STACK (stack);
-    real_cur = BTOR_REAL_ADDR_AIG (cur);
-
-    if (btor_aig_is_const (real_cur)) continue;
-    if (btor_hashint_map_contains (aprop->score, btor_aig_get_id (cur)))
-      continue;
-
-    if (!btor_hashint_table_contains (cache, real_cur->id))
-    {
-      btor_hashint_table_add (cache, real_cur->id);
-      assert (btor_aig_is_var (real_cur) || btor_aig_is_and (real_cur));
-      BTOR_PUSH_STACK (stack, cur);
-      if (btor_aig_is_and (real_cur))
-      {
-        left  = btor_aig_get_left_child (aprop->amgr, real_cur);
-        right = btor_aig_get_right_child (aprop->amgr, real_cur);
-        if (!btor_aig_is_const (left)
-            && !btor_hashint_table_contains (cache,
-                                             BTOR_REAL_ADDR_AIG (left)->id))
-          BTOR_PUSH_STACK (stack, left);
-        if (!btor_aig_is_const (right)
-            && !btor_hashint_table_contains (cache,
-                                             BTOR_REAL_ADDR_AIG (right)->id))
-          BTOR_PUSH_STACK (stack, right);
-      }
-    }
+    id  = BTOR_PEEK_STACK (aprop->nodes, i);
+    aig = BTOR_PEEK_STACK (aprop->amgr->id2aig, id);
+    if (btor_aig_is_var (aig))
+      compute_score_var (aprop, id);
     else
-    {
-      compute_score_aig (aprop, cur);
-    }
+      compute_score_and (aprop, aig);
   }
-
-  /* cleanup */
-  BTOR_RELEASE_STACK (stack);
-  btor_hashint_table_delete (cache);
 }
 
 /*------------------------------------------------------------------------*/
 
-static void
-recursively_compute_assignment (AIGProp *aprop, BtorAIG *aig)
+static inline int32_t
+compute_assignment_and (AIGProp *aprop, BtorAIG *aig)
 {
   assert (aprop);
-  assert (aprop->model);
-  assert (aig);
-
-  int32_t aleft, aright;
-  BtorAIG *cur, *real_cur, *left, *right;
-  BtorAIGPtrStack stack;
-  BtorIntHashTable *cache;
-  BtorMemMgr *mm;
-
-  if (btor_aig_is_const (aig)) return;
-
-  mm = aprop->amgr->btor->mm;
-
-  cache = btor_hashint_table_new (mm);
-  BTOR_INIT_STACK (mm, stack);
-  BTOR_PUSH_STACK (stack, aig);
-
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur      = BTOR_POP_STACK (stack);
-    real_cur = BTOR_REAL_ADDR_AIG (cur);
-    assert (!btor_aig_is_const (real_cur));
-    if (btor_hashint_map_contains (aprop->model, real_cur->id)) continue;
-
-    if (btor_aig_is_var (real_cur))
-    {
-      /* initialize with false */
-      btor_hashint_map_add (aprop->model, real_cur->id)->as_int = -1;
-    }
-    else
-    {
-      assert (btor_aig_is_and (real_cur));
-      left  = btor_aig_get_left_child (aprop->amgr, real_cur);
-      right = btor_aig_get_right_child (aprop->amgr, real_cur);
-
-      if (!btor_hashint_table_contains (cache, real_cur->id))
-      {
-        btor_hashint_table_add (cache, real_cur->id);
-        BTOR_PUSH_STACK (stack, cur);
-        if (!btor_aig_is_const (left)
-            && !btor_hashint_table_contains (cache,
-                                             BTOR_REAL_ADDR_AIG (left)->id))
-          BTOR_PUSH_STACK (stack, left);
-        if (!btor_aig_is_const (right)
-            && !btor_hashint_table_contains (cache,
-                                             BTOR_REAL_ADDR_AIG (right)->id))
-          BTOR_PUSH_STACK (stack, right);
-      }
-      else
-      {
-        aleft = aigprop_get_assignment_aig (aprop, left);
-        assert (aleft);
-        aright = aigprop_get_assignment_aig (aprop, right);
-        assert (aright);
-        if (aleft < 0 || aright < 0)
-          btor_hashint_map_add (aprop->model, real_cur->id)->as_int = -1;
-        else
-          btor_hashint_map_add (aprop->model, real_cur->id)->as_int = 1;
-      }
-    }
-  }
+  assert (BTOR_IS_REGULAR_AIG (aig));
+  assert (btor_aig_is_and (aig));
 
-  btor_hashint_table_delete (cache);
-  BTOR_RELEASE_STACK (stack);
+  return get_assignment_id (aprop, aig->children[0]) < 0
+                 || get_assignment_id (aprop, aig->children[1]) < 0
+             ? -1
+             : 1;
 }
 
 void
@@ -415,7 +238,7 @@ aigprop_delete_model (AIGProp *aprop)
   assert (aprop);
 
   if (!aprop->model) return;
-  btor_hashint_map_delete (aprop->model);
+  BTOR_DELETEN (aprop->amgr->btor->mm, aprop->model, aprop->size);
   aprop->model = 0;
 }
 
@@ -425,7 +248,7 @@ aigprop_init_model (AIGProp *aprop)
   assert (aprop);
 
   if (aprop->model) aigprop_delete_model (aprop);
-  aprop->model = btor_hashint_map_new (aprop->amgr->btor->mm);
+  BTOR_CNEWN (aprop->amgr->btor->mm, aprop->model, aprop->size);
 }
 
 void
@@ -434,14 +257,92 @@ aigprop_generate_model (AIGProp *aprop, bool reset)
   assert (aprop);
   assert (aprop->roots);
 
-  BtorIntHashTableIterator it;
+  uint32_t i;
+  int32_t id;
+  BtorAIG *aig;
 
-  if (reset) aigprop_init_model (aprop);
+  if (reset || !aprop->model) aigprop_init_model (aprop);
 
-  btor_iter_hashint_init (&it, aprop->roots);
-  while (btor_iter_hashint_has_next (&it))
-    recursively_compute_assignment (
-        aprop, btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it)));
+  /* AIG ids are topologically ordered */
+  for (i = 0; i < BTOR_COUNT_STACK (aprop->nodes); i++)
+  {
+    id  = BTOR_PEEK_STACK (aprop->nodes, i);
+    aig = BTOR_PEEK_STACK (aprop->amgr->id2aig, id);
+    if (btor_aig_is_var (aig))
+    {
+      /* initialize with false */
+      if (!aprop->model[id]) aprop->model[id] = -1;
+    }
+    else
+    {
+      aprop->model[id] = compute_assignment_and (aprop, aig);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+static int32_t
+cmp_int_asc (const void *a, const void *b)
+{
+  return *(const int32_t *) a - *(const int32_t *) b;
+}
+
+static inline void
+next_stamp (AIGProp *aprop)
+{
+  assert (aprop);
+
+  aprop->stamp += 1;
+  if (!aprop->stamp)
+  {
+    memset (aprop->mark, 0, aprop->size * sizeof (*aprop->mark));
+    aprop->stamp = 1;
+  }
+}
+
+/* Collect the ids of the AIGs in the cone of the given 'n' (regular) inputs,
+ * excluding the inputs, into aprop->cone in ascending (topological) order.
+ * The inputs and their cone are marked with the current stamp. */
+static void
+collect_cone (AIGProp *aprop, int32_t *inputs, uint32_t n)
+{
+  assert (aprop);
+  assert (inputs);
+
+  uint32_t i, j;
+  int32_t id, pid;
+
+  next_stamp (aprop);
+  BTOR_RESET_STACK (aprop->cone);
+  BTOR_RESET_STACK (aprop->stack);
+
+  for (i = 0; i < n; i++)
+  {
+    id = inputs[i];
+    assert (id > 0 && (uint32_t) id < aprop->size);
+    if (aprop->mark[id] == aprop->stamp) continue;
+    aprop->mark[id] = aprop->stamp;
+    BTOR_PUSH_STACK (aprop->stack, id);
+  }
+
+  while (!BTOR_EMPTY_STACK (aprop->stack))
+  {
+    id = BTOR_POP_STACK (aprop->stack);
+    for (j = aprop->pstart[id]; j < aprop->pstart[id + 1]; j++)
+    {
+      pid = aprop->parents[j];
+      if (aprop->mark[pid] == aprop->stamp) continue;
+      aprop->mark[pid] = aprop->stamp;
+      BTOR_PUSH_STACK (aprop->stack, pid);
+      BTOR_PUSH_STACK (aprop->cone, pid);
+    }
+  }
+
+  qsort (aprop->cone.start,
+         BTOR_COUNT_STACK (aprop->cone),
+         sizeof (int32_t),
+         cmp_int_asc);
 }
 
 /*------------------------------------------------------------------------*/
@@ -486,214 +387,109 @@ update_unsatroots_table (AIGProp *aprop, BtorAIG *aig, int32_t assignment)
   }
 }
 
+#ifndef NDEBUG
 static void
-update_cone (AIGProp *aprop, BtorAIG *aig, int32_t assignment)
+check_unsatroots_dbg (AIGProp *aprop)
 {
   assert (aprop);
-  assert (aig);
-  assert (BTOR_IS_REGULAR_AIG (aig));
-  assert (btor_aig_is_var (aig));
-  assert (assignment == 1 || assignment == -1);
-
-  int32_t aleft, aright, ass, leftid, rightid;
-  uint32_t i;
-  double start, delta, sleft, sright, s;
-  BtorIntHashTable *cache;
-  BtorHashTableData *d;
-  BtorAIGPtrStack stack, cone;
-  BtorIntStack *parents;
-  BtorAIG *cur, *left, *right;
-  BtorMemMgr *mm;
-
-  start = btor_util_time_stamp ();
-
-  mm = aprop->amgr->btor->mm;
 
-#ifndef NDEBUG
+  int32_t a;
   BtorIntHashTableIterator it;
   BtorAIG *root;
+
   btor_iter_hashint_init (&it, aprop->roots);
   while (btor_iter_hashint_has_next (&it))
   {
     root = btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it));
     assert (!btor_aig_is_false (root));
-    if ((!BTOR_IS_INVERTED_AIG (root)
-         && aigprop_get_assignment_aig (aprop, BTOR_REAL_ADDR_AIG (root)) == -1)
-        || (BTOR_IS_INVERTED_AIG (root)
-            && aigprop_get_assignment_aig (aprop, BTOR_REAL_ADDR_AIG (root))
-                   == 1))
-    {
+    a = aigprop_get_assignment_aig (aprop, root);
+    assert (a == 1 || a == -1);
+    if (a == -1)
       assert (btor_hashint_map_contains (aprop->unsatroots,
                                          btor_aig_get_id (root)));
-    }
-    else if ((!BTOR_IS_INVERTED_AIG (root)
-              && aigprop_get_assignment_aig (aprop, BTOR_REAL_ADDR_AIG (root))
-                     == 1)
-             || (BTOR_IS_INVERTED_AIG (root)
-                 && aigprop_get_assignment_aig (aprop,
-                                                BTOR_REAL_ADDR_AIG (root))
-                        == -1))
-    {
+    else
       assert (!btor_hashint_map_contains (aprop->unsatroots,
                                           btor_aig_get_id (root)));
-    }
   }
+}
+#endif
+
+static void
+update_cone (AIGProp *aprop, BtorAIG *aig, int32_t assignment)
+{
+  assert (aprop);
+  assert (aig);
+  assert (BTOR_IS_REGULAR_AIG (aig));
+  assert (btor_aig_is_var (aig));
+  assert (assignment == 1 || assignment == -1);
+
+  int32_t ass;
+  uint32_t i;
+  double start, delta;
+  BtorAIG *cur;
+
+  start = btor_util_time_stamp ();
+
+#ifndef NDEBUG
+  check_unsatroots_dbg (aprop);
 #endif
 
   /* reset cone ----------------------------------------------------------- */
 
-  BTOR_INIT_STACK (mm, cone);
-  BTOR_INIT_STACK (mm, stack);
-  cache = btor_hashint_table_new (mm);
-  BTOR_PUSH_STACK (stack, aig);
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur = BTOR_POP_STACK (stack);
-    assert (BTOR_IS_REGULAR_AIG (cur));
-    if (btor_hashint_table_contains (cache, cur->id)) continue;
-    btor_hashint_table_add (cache, cur->id);
-    if (cur != aig) BTOR_PUSH_STACK (cone, cur);
-    assert (btor_hashint_map_contains (aprop->parents, cur->id));
-    parents = btor_hashint_map_get (aprop->parents, cur->id)->as_ptr;
-    for (i = 0; i < BTOR_COUNT_STACK (*parents); i++)
-      BTOR_PUSH_STACK (
-          stack,
-          btor_aig_get_by_id (aprop->amgr, BTOR_PEEK_STACK (*parents, i)));
-  }
-  BTOR_RELEASE_STACK (stack);
-  btor_hashint_table_delete (cache);
+  collect_cone (aprop, &aig->id, 1);
 
   aprop->time.update_cone_reset += btor_util_time_stamp () - start;
 
   /* update assignment and score of 'aig' --------------------------------- */
-  /* update model */
-  d = btor_hashint_map_get (aprop->model, aig->id);
-  assert (d);
   /* update unsatroots table */
-  if (d->as_int != assignment
-      && (btor_hashint_table_contains (aprop->roots, aig->id)
-          || btor_hashint_table_contains (aprop->roots, -aig->id)))
+  if (aprop->model[aig->id] != assignment && aprop->isroot[aig->id])
     update_unsatroots_table (aprop, aig, assignment);
-  d->as_int = assignment;
+  /* update model */
+  aprop->model[aig->id] = assignment;
 
   /* update score */
   if (aprop->score)
   {
-    d         = btor_hashint_map_get (aprop->score, aig->id);
-    d->as_dbl = assignment < 0 ? 0.0 : 1.0;
-    d         = btor_hashint_map_get (aprop->score, -aig->id);
-    d->as_dbl = assignment < 0 ? 1.0 : 0.0;
+    aprop->score[2 * aig->id]     = assignment < 0 ? 0.0 : 1.0;
+    aprop->score[2 * aig->id + 1] = assignment < 0 ? 1.0 : 0.0;
   }
 
-  qsort (cone.start,
-         BTOR_COUNT_STACK (cone),
-         sizeof (BtorAIG *),
-         btor_compare_aig_by_id_qsort_asc);
-
   /* update model of cone ------------------------------------------------- */
 
   delta = btor_util_time_stamp ();
 
-  for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+  for (i = 0; i < BTOR_COUNT_STACK (aprop->cone); i++)
   {
-    cur = BTOR_PEEK_STACK (cone, i);
+    cur = BTOR_PEEK_STACK (aprop->amgr->id2aig,
+                           BTOR_PEEK_STACK (aprop->cone, i));
     assert (BTOR_IS_REGULAR_AIG (cur));
     assert (btor_aig_is_and (cur));
-    assert (btor_hashint_map_contains (aprop->model, cur->id));
-
-    left  = btor_aig_get_left_child (aprop->amgr, cur);
-    right = btor_aig_get_right_child (aprop->amgr, cur);
-    aleft = aigprop_get_assignment_aig (aprop, left);
-    assert (aleft);
-    aright = aigprop_get_assignment_aig (aprop, right);
-    assert (aright);
-    ass = aleft < 0 || aright < 0 ? -1 : 1;
-    d   = btor_hashint_map_get (aprop->model, cur->id);
-    assert (d);
+    assert (aprop->model[cur->id]);
+
+    ass = compute_assignment_and (aprop, cur);
     /* update unsatroots table */
-    if (d->as_int != ass
-        && (btor_hashint_table_contains (aprop->roots, cur->id)
-            || btor_hashint_table_contains (aprop->roots, -cur->id)))
+    if (aprop->model[cur->id] != ass && aprop->isroot[cur->id])
       update_unsatroots_table (aprop, cur, ass);
-    d->as_int = ass;
+    aprop->model[cur->id] = ass;
   }
 
   aprop->time.update_cone_model_gen += btor_util_time_stamp () - delta;
-  delta = btor_util_time_stamp ();
 
   /* update score of cone ------------------------------------------------- */
 
   if (aprop->score)
   {
     delta = btor_util_time_stamp ();
-    for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
-    {
-      cur = BTOR_PEEK_STACK (cone, i);
-      assert (BTOR_IS_REGULAR_AIG (cur));
-      assert (btor_aig_is_and (cur));
-      assert (btor_hashint_map_contains (aprop->score, cur->id));
-      assert (btor_hashint_map_contains (aprop->score, -cur->id));
-
-      left    = btor_aig_get_left_child (aprop->amgr, cur);
-      right   = btor_aig_get_right_child (aprop->amgr, cur);
-      leftid  = btor_aig_get_id (left);
-      rightid = btor_aig_get_id (right);
-
-      sleft = btor_aig_is_const (left)
-                  ? (btor_aig_is_true (left) ? 1.0 : 0.0)
-                  : btor_hashint_map_get (aprop->score, leftid)->as_dbl;
-      sright = btor_aig_is_const (right)
-                   ? (btor_aig_is_true (right) ? 1.0 : 0.0)
-                   : btor_hashint_map_get (aprop->score, rightid)->as_dbl;
-      s = (sleft + sright) / 2.0;
-      /* fix rounding errors (eg. (0.999+1.0)/2 = 1.0) ->
-         choose minimum (else it might again result in 1.0) */
-      if (s == 1.0 && (sleft < 1.0 || sright < 1.0))
-        s = sleft < sright ? sleft : sright;
-      assert (s >= 0.0 && s <= 1.0);
-      btor_hashint_map_get (aprop->score, cur->id)->as_dbl = s;
-
-      sleft = btor_aig_is_const (left)
-                  ? (btor_aig_is_true (left) ? 0.0 : 1.0)
-                  : btor_hashint_map_get (aprop->score, -leftid)->as_dbl;
-      sright = btor_aig_is_const (right)
-                   ? (btor_aig_is_true (right) ? 1.0 : 0.0)
-                   : btor_hashint_map_get (aprop->score, -rightid)->as_dbl;
-      s = sleft > sright ? sleft : sright;
-      assert (s >= 0.0 && s <= 1.0);
-      btor_hashint_map_get (aprop->score, -cur->id)->as_dbl = s;
-    }
+    for (i = 0; i < BTOR_COUNT_STACK (aprop->cone); i++)
+      compute_score_and (
+          aprop,
+          BTOR_PEEK_STACK (aprop->amgr->id2aig,
+                           BTOR_PEEK_STACK (aprop->cone, i)));
     aprop->time.update_cone_compute_score += btor_util_time_stamp () - delta;
   }
 
-  BTOR_RELEASE_STACK (cone);
-
 #ifndef NDEBUG
-  btor_iter_hashint_init (&it, aprop->roots);
-  while (btor_iter_hashint_has_next (&it))
-  {
-    root = btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it));
-    if ((!BTOR_IS_INVERTED_AIG (root)
-         && aigprop_get_assignment_aig (aprop, BTOR_REAL_ADDR_AIG (root)) == -1)
-        || (BTOR_IS_INVERTED_AIG (root)
-            && aigprop_get_assignment_aig (aprop, BTOR_REAL_ADDR_AIG (root))
-                   == 1))
-    {
-      assert (btor_hashint_map_contains (aprop->unsatroots,
-                                         btor_aig_get_id (root)));
-    }
-    else if ((!BTOR_IS_INVERTED_AIG (root)
-              && aigprop_get_assignment_aig (aprop, BTOR_REAL_ADDR_AIG (root))
-                     == 1)
-             || (BTOR_IS_INVERTED_AIG (root)
-                 && aigprop_get_assignment_aig (aprop,
-                                                BTOR_REAL_ADDR_AIG (root))
-                        == -1))
-    {
-      assert (!btor_hashint_map_contains (aprop->unsatroots,
-                                          btor_aig_get_id (root)));
-    }
-  }
+  check_unsatroots_dbg (aprop);
 #endif
 
   aprop->time.update_cone += btor_util_time_stamp () - start;
@@ -719,7 +515,6 @@ select_root (AIGProp *aprop, uint32_t nmoves)
   {
     int32_t *selected;
     double value, max_value, score;
-    BtorHashTableData *d;
 
     max_value = 0.0;
     btor_iter_hashint_init (&it, aprop->unsatroots);
@@ -729,9 +524,7 @@ select_root (AIGProp *aprop, uint32_t nmoves)
       cur      = btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it));
       assert (aigprop_get_assignment_aig (aprop, cur) != 1);
       assert (!btor_aig_is_const (cur));
-      d = btor_hashint_map_get (aprop->score, btor_aig_get_id (cur));
-      assert (d);
-      score = d->as_dbl;
+      score = get_score_id (aprop, btor_aig_get_id (cur));
       assert (score < 1.0);
       if (!res)
       {
@@ -792,7 +585,6 @@ select_move (AIGProp *aprop,
   int32_t i, asscur, ass[2], assnew;
   uint32_t eidx;
   BtorAIG *cur, *real_cur, *c[2];
-  BtorHashTableData *d;
 
   *input      = 0;
   *assignment = 0;
@@ -830,14 +622,7 @@ select_move (AIGProp *aprop,
         /* choose 0-branch if exactly one branch is 0,
          * else choose randomly */
         for (i = 0; i < 2; i++)
-        {
-          assert (btor_hashint_map_get (aprop->model,
-                                        BTOR_REAL_ADDR_AIG (c[i])->id));
-          d = btor_hashint_map_get (aprop->model,
-                                    BTOR_REAL_ADDR_AIG (c[i])->id);
-          assert (d);
-          ass[i] = BTOR_IS_INVERTED_AIG (c[i]) ? -d->as_int : d->as_int;
-        }
+          ass[i] = get_assignment_id (aprop, real_cur->children[i]);
         if (ass[0] == -1 && ass[1] == 1)
           eidx = 0;
         else if (ass[0] == 1 && ass[1] == -1)
@@ -868,6 +653,101 @@ select_move (AIGProp *aprop,
   }
 }
 
+/* Select the best out of 'aprop->nsamples' propagation moves for 'root',
+ * i.e., the move that maximizes the number of satisfied roots. All sampled
+ * moves are evaluated at once via bit-parallel simulation of the cones of
+ * their inputs, where bit i of a simulation word corresponds to the
+ * assignment under sampled move i. */
+static void
+select_move_sampled (AIGProp *aprop,
+                     BtorAIG *root,
+                     BtorAIG **input,
+                     int32_t *assignment)
+{
+  assert (aprop);
+  assert (aprop->nsamples > 1 && aprop->nsamples <= AIGPROP_MAX_NSAMPLES);
+  assert (root);
+  assert (input);
+  assert (assignment);
+
+  uint32_t i, j, n, best;
+  int32_t id, left, right, gain[AIGPROP_MAX_NSAMPLES];
+  int32_t ids[AIGPROP_MAX_NSAMPLES], ass[AIGPROP_MAX_NSAMPLES];
+  uint64_t val, lval, rval;
+  BtorAIG *inputs[AIGPROP_MAX_NSAMPLES], *aig;
+
+  n = aprop->nsamples;
+  for (i = 0; i < n; i++)
+  {
+    select_move (aprop, root, &inputs[i], &ass[i]);
+    assert (inputs[i]);
+    ids[i]  = inputs[i]->id;
+    gain[i] = 0;
+  }
+
+  collect_cone (aprop, ids, n);
+
+  /* value of an unaffected node is its current assignment in every bit */
+#define AIGPROP_SIM_VALUE(id)                                         \
+  (aprop->mark[abs (id)] == aprop->stamp                              \
+       ? ((id) < 0 ? ~aprop->sim[-(id)] : aprop->sim[(id)])           \
+       : (get_assignment_id (aprop, (id)) < 0 ? 0 : ~(uint64_t) 0))
+
+  /* inputs */
+  for (i = 0; i < n; i++)
+    aprop->sim[ids[i]] = aprop->model[ids[i]] < 0 ? 0 : ~(uint64_t) 0;
+  for (i = 0; i < n; i++)
+    if (aprop->model[ids[i]] != ass[i])
+      aprop->sim[ids[i]] ^= (uint64_t) 1 << i;
+
+  /* cone */
+  for (i = 0; i < BTOR_COUNT_STACK (aprop->cone); i++)
+  {
+    id  = BTOR_PEEK_STACK (aprop->cone, i);
+    aig = BTOR_PEEK_STACK (aprop->amgr->id2aig, id);
+    assert (btor_aig_is_and (aig));
+    left           = aig->children[0];
+    right          = aig->children[1];
+    lval           = AIGPROP_SIM_VALUE (left);
+    rval           = AIGPROP_SIM_VALUE (right);
+    aprop->sim[id] = lval & rval;
+  }
+
+  /* number of roots that change from unsatisfied to satisfied (and vice
+   * versa) under each sampled move */
+  for (i = 0; i < n + BTOR_COUNT_STACK (aprop->cone); i++)
+  {
+    id = i < n ? ids[i] : BTOR_PEEK_STACK (aprop->cone, i - n);
+    if (!aprop->isroot[id]) continue;
+    if (i < n)
+    {
+      /* input selected by more than one sampled move */
+      for (j = 0; j < i && ids[j] != id; j++)
+        ;
+      if (j < i) continue;
+    }
+    if (aprop->isroot[id] & AIGPROP_ROOT_NEG) id = -id;
+    val = AIGPROP_SIM_VALUE (id);
+    for (j = 0; j < n; j++)
+    {
+      if (get_assignment_id (aprop, id) < 0)
+        gain[j] += (val >> j) & 1;
+      else
+        gain[j] -= !((val >> j) & 1);
+    }
+  }
+#undef AIGPROP_SIM_VALUE
+
+  for (i = 1, best = 0; i < n; i++)
+    if (gain[i] > gain[best]) best = i;
+
+  AIGPROPLOG (1, "");
+  AIGPROPLOG (1, "*** select move %u of %u (gain: %d)", best, n, gain[best]);
+
+  *input      = inputs[best];
+  *assignment = ass[best];
+}
+
 static int32_t
 move (AIGProp *aprop, uint32_t nmoves)
 {
@@ -882,7 +762,10 @@ move (AIGProp *aprop, uint32_t nmoves)
   /* roots contain false AIG -> unsat */
   if (!(root = select_root (aprop, nmoves))) return 0;
 
-  select_move (aprop, root, &input, &assignment);
+  if (aprop->nsamples > 1)
+    select_move_sampled (aprop, root, &input, &assignment);
+  else
+    select_move (aprop, root, &input, &assignment);
 
   AIGPROPLOG (1, "");
   AIGPROPLOG (1, "*** move");
@@ -903,6 +786,113 @@ move (AIGProp *aprop, uint32_t nmoves)
 
 /*------------------------------------------------------------------------*/
 
+/* Collect all AIGs in the cones of the roots (in topological order) and
+ * their parents. */
+static void
+init_cones (AIGProp *aprop)
+{
+  assert (aprop);
+  assert (aprop->roots);
+
+  uint32_t i, j;
+  int32_t id, cid;
+  BtorAIG *aig;
+  BtorIntHashTableIterator it;
+  BtorMemMgr *mm;
+
+  mm          = aprop->amgr->btor->mm;
+  aprop->size = BTOR_COUNT_STACK (aprop->amgr->id2aig);
+
+  BTOR_CNEWN (mm, aprop->mark, aprop->size);
+  BTOR_CNEWN (mm, aprop->isroot, aprop->size);
+  BTOR_CNEWN (mm, aprop->pstart, aprop->size + 1);
+  if (aprop->nsamples > 1) BTOR_CNEWN (mm, aprop->sim, aprop->size);
+  aprop->stamp = 1;
+
+  BTOR_INIT_STACK (mm, aprop->nodes);
+  BTOR_INIT_STACK (mm, aprop->cone);
+  BTOR_INIT_STACK (mm, aprop->stack);
+
+  btor_iter_hashint_init (&it, aprop->roots);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    id  = btor_iter_hashint_next (&it);
+    aig = btor_aig_get_by_id (aprop->amgr, id);
+    if (btor_aig_is_const (aig)) continue;
+    aprop->isroot[abs (id)] |= id < 0 ? AIGPROP_ROOT_NEG : AIGPROP_ROOT_POS;
+    if (aprop->mark[abs (id)]) continue;
+    aprop->mark[abs (id)] = 1;
+    BTOR_PUSH_STACK (aprop->stack, abs (id));
+  }
+
+  while (!BTOR_EMPTY_STACK (aprop->stack))
+  {
+    id = BTOR_POP_STACK (aprop->stack);
+    BTOR_PUSH_STACK (aprop->nodes, id);
+    aig = BTOR_PEEK_STACK (aprop->amgr->id2aig, id);
+    if (!btor_aig_is_and (aig)) continue;
+    for (i = 0; i < 2; i++)
+    {
+      cid = abs (aig->children[i]);
+      /* count parents, shifted by one for computing the offsets below */
+      aprop->pstart[cid + 1] += 1;
+      if (aprop->mark[cid]) continue;
+      aprop->mark[cid] = 1;
+      BTOR_PUSH_STACK (aprop->stack, cid);
+    }
+  }
+
+  qsort (aprop->nodes.start,
+         BTOR_COUNT_STACK (aprop->nodes),
+         sizeof (int32_t),
+         cmp_int_asc);
+
+  for (i = 1; i <= aprop->size; i++) aprop->pstart[i] += aprop->pstart[i - 1];
+  if (aprop->pstart[aprop->size])
+    BTOR_NEWN (mm, aprop->parents, aprop->pstart[aprop->size]);
+  for (i = 0; i < BTOR_COUNT_STACK (aprop->nodes); i++)
+  {
+    id  = BTOR_PEEK_STACK (aprop->nodes, i);
+    aig = BTOR_PEEK_STACK (aprop->amgr->id2aig, id);
+    if (!btor_aig_is_and (aig)) continue;
+    for (j = 0; j < 2; j++)
+    {
+      /* use pstart[cid] as fill position, restored below */
+      cid                                  = abs (aig->children[j]);
+      aprop->parents[aprop->pstart[cid]++] = id;
+    }
+  }
+  for (i = aprop->size; i > 0; i--) aprop->pstart[i] = aprop->pstart[i - 1];
+  aprop->pstart[0] = 0;
+}
+
+static void
+delete_cones (AIGProp *aprop)
+{
+  assert (aprop);
+
+  BtorMemMgr *mm;
+
+  mm = aprop->amgr->btor->mm;
+
+  if (aprop->parents)
+    BTOR_DELETEN (mm, aprop->parents, aprop->pstart[aprop->size]);
+  aprop->parents = 0;
+  BTOR_DELETEN (mm, aprop->pstart, aprop->size + 1);
+  aprop->pstart = 0;
+  BTOR_DELETEN (mm, aprop->isroot, aprop->size);
+  aprop->isroot = 0;
+  BTOR_DELETEN (mm, aprop->mark, aprop->size);
+  aprop->mark = 0;
+  if (aprop->sim) BTOR_DELETEN (mm, aprop->sim, aprop->size);
+  aprop->sim = 0;
+  if (aprop->score) BTOR_DELETEN (mm, aprop->score, 2 * aprop->size);
+  aprop->score = 0;
+  BTOR_RELEASE_STACK (aprop->nodes);
+  BTOR_RELEASE_STACK (aprop->cone);
+  BTOR_RELEASE_STACK (aprop->stack);
+}
+
 // TODO termination callback?
 int32_t
 aigprop_sat (AIGProp *aprop, BtorIntHashTable *roots)
@@ -911,84 +901,32 @@ aigprop_sat (AIGProp *aprop, BtorIntHashTable *roots)
   assert (roots);
 
   double start;
-  int32_t i, j, max_steps, sat_result, rootid, childid;
+  int32_t j, max_steps, sat_result, rootid;
   uint32_t nmoves;
   BtorMemMgr *mm;
-  BtorIntHashTable *cache;
   BtorIntHashTableIterator it;
-  BtorHashTableData *d;
-  BtorAIGPtrStack stack;
-  BtorIntStack *childparents;
-  BtorAIG *root, *cur, *child;
+  BtorAIG *root;
+  BtorLsController *ctrl;
 
   start      = btor_util_time_stamp ();
   sat_result = AIGPROP_UNKNOWN;
   nmoves     = 0;
+  ctrl       = 0;
 
   mm           = aprop->amgr->btor->mm;
   aprop->roots = roots;
 
-  /* collect parents (for cone computation) */
-  BTOR_INIT_STACK (mm, stack);
-  cache = btor_hashint_map_new (mm);
-  assert (!aprop->parents);
-  aprop->parents = btor_hashint_map_new (mm);
-
-  btor_iter_hashint_init (&it, roots);
-  while (btor_iter_hashint_has_next (&it))
-  {
-    cur = btor_aig_get_by_id (aprop->amgr, btor_iter_hashint_next (&it));
-    if (btor_aig_is_const (cur)) continue;
-    BTOR_PUSH_STACK (stack, cur);
-  }
-
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur = BTOR_REAL_ADDR_AIG (BTOR_POP_STACK (stack));
-    assert (!btor_aig_is_const (cur));
-
-    if ((d = btor_hashint_map_get (cache, cur->id)) && d->as_int == 1) continue;
-
-    if (!d)
-    {
-      btor_hashint_map_add (cache, cur->id);
-      BTOR_PUSH_STACK (stack, cur);
-      BTOR_NEW (mm, childparents);
-      BTOR_INIT_STACK (mm, *childparents);
-      btor_hashint_map_add (aprop->parents, cur->id)->as_ptr = childparents;
-      if (btor_aig_is_and (cur))
-      {
-        for (i = 0; i < 2; i++)
-        {
-          child = btor_aig_get_by_id (aprop->amgr, cur->children[i]);
-          if (!btor_aig_is_const (child)) BTOR_PUSH_STACK (stack, child);
-        }
-      }
-    }
-    else
-    {
-      assert (d->as_int == 0);
-      d->as_int = 1;
-      if (btor_aig_is_var (cur)) continue;
-      for (i = 0; i < 2; i++)
-      {
-        if (btor_aig_is_const (
-                btor_aig_get_by_id (aprop->amgr, cur->children[i])))
-          continue;
-        childid = cur->children[i] < 0 ? -cur->children[i] : cur->children[i];
-        assert (btor_hashint_map_contains (aprop->parents, childid));
-        childparents = btor_hashint_map_get (aprop->parents, childid)->as_ptr;
-        assert (childparents);
-        BTOR_PUSH_STACK (*childparents, cur->id);
-      }
-    }
-  }
-  btor_hashint_map_delete (cache);
-  BTOR_RELEASE_STACK (stack);
+  /* collect cones and parents (for cone computation) */
+  init_cones (aprop);
 
   /* generate initial model, all inputs are initialized with false */
   aigprop_generate_model (aprop, true);
 
+  /* there are no probabilities to adapt, only the restart schedule */
+  if (aprop->use_adaptive && aprop->use_restarts)
+    ctrl = btor_lsutils_new_controller (
+        aprop->amgr->btor, 0, 0, roots->count, true, 0, 0);
+
   for (;;)
   {
     /* collect unsatisfied roots (kept up-to-date in update_cone) */
@@ -1013,19 +951,22 @@ aigprop_sat (AIGProp *aprop, BtorIntHashTable *roots)
 
     if (!aprop->unsatroots->count) goto SAT;
 
+    if (ctrl) btor_lsutils_controller_start (ctrl, aprop->unsatroots->count);
+
     for (j = 0, max_steps = AIGPROP_MAXSTEPS (aprop->stats.restarts + 1);
-         !aprop->use_restarts || j < max_steps;
+         ctrl || !aprop->use_restarts || j < max_steps;
          j++)
     {
       if (!(move (aprop, nmoves))) goto UNSAT;
       nmoves += 1;
       if (!aprop->unsatroots->count) goto SAT;
+      if (ctrl
+          && btor_lsutils_controller_move (ctrl, aprop->unsatroots->count))
+        break;
     }
 
     /* restart */
     aigprop_generate_model (aprop, true);
-    btor_hashint_map_delete (aprop->score);
-    aprop->score = 0;
     btor_hashint_map_delete (aprop->unsatroots);
     aprop->unsatroots = 0;
     aprop->stats.restarts += 1;
@@ -1036,21 +977,15 @@ SAT:
 UNSAT:
   sat_result = AIGPROP_UNSAT;
 DONE:
-  btor_iter_hashint_init (&it, aprop->parents);
-  while (btor_iter_hashint_has_next (&it))
+  if (ctrl)
   {
-    childparents = btor_iter_hashint_next_data (&it)->as_ptr;
-    assert (childparents);
-    BTOR_RELEASE_STACK (*childparents);
-    BTOR_DELETE (mm, childparents);
+    btor_lsutils_print_controller_trace (ctrl);
+    btor_lsutils_delete_controller (ctrl);
   }
-  btor_hashint_map_delete (aprop->parents);
-  aprop->parents = 0;
+  delete_cones (aprop);
   if (aprop->unsatroots) btor_hashint_map_delete (aprop->unsatroots);
   aprop->unsatroots = 0;
   aprop->roots      = 0;
-  if (aprop->score) btor_hashint_map_delete (aprop->score);
-  aprop->score = 0;
 
   aprop->time.sat += btor_util_time_stamp () - start;
   return sat_result;
@@ -1066,6 +1001,10 @@ aigprop_clone_aigprop (BtorAIGMgr *clone, AIGProp *aprop)
 
   if (!aprop) return 0;
 
+  /* cones only exist during aigprop_sat */
+  assert (!aprop->mark);
+  assert (!aprop->score);
+
   mm = clone->btor->mm;
 
   BTOR_CNEW (mm, res);
@@ -1074,10 +1013,11 @@ aigprop_clone_aigprop (BtorAIGMgr *clone, AIGProp *aprop)
   res->amgr = clone;
   res->unsatroots =
       btor_hashint_map_clone (mm, aprop->unsatroots, btor_clone_data_as_int, 0);
-  res->score =
-      btor_hashint_map_clone (mm, aprop->score, btor_clone_data_as_dbl, 0);
-  res->model =
-      btor_hashint_map_clone (mm, aprop->model, btor_clone_data_as_int, 0);
+  if (aprop->model)
+  {
+    BTOR_NEWN (mm, res->model, aprop->size);
+    memcpy (res->model, aprop->model, aprop->size * sizeof (*aprop->model));
+  }
   return res;
 }
 
@@ -1086,9 +1026,12 @@ aigprop_new_aigprop (BtorAIGMgr *amgr,
                      uint32_t loglevel,
                      uint32_t seed,
                      uint32_t use_restarts,
-                     uint32_t use_bandit)
+                     uint32_t use_bandit,
+                     uint32_t nsamples,
+                     uint32_t use_adaptive)
 {
   assert (amgr);
+  assert (nsamples > 0 && nsamples <= AIGPROP_MAX_NSAMPLES);
 
   AIGProp *res;
 
@@ -1099,6 +1042,8 @@ aigprop_new_aigprop (BtorAIGMgr *amgr,
   res->seed         = seed;
   res->use_restarts = use_restarts;
   res->use_bandit   = use_bandit;
+  res->nsamples     = nsamples;
+  res->use_adaptive = use_adaptive;
 
   return res;
 }
@@ -1110,8 +1055,7 @@ aigprop_delete_aigprop (AIGProp *aprop)
 
   btor_rng_delete (&aprop->rng);
   if (aprop->unsatroots) btor_hashint_map_delete (aprop->unsatroots);
-  if (aprop->score) btor_hashint_map_delete (aprop->score);
-  if (aprop->model) btor_hashint_map_delete (aprop->model);
+  aigprop_delete_model (aprop);
   BTOR_DELETE (aprop->amgr->btor->mm, aprop);
 }
 
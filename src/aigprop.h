@@ -12,19 +12,37 @@
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btorrng.h"
+#include "utils/btorstack.h"
 
 #define AIGPROP_UNKNOWN 0
 #define AIGPROP_SAT 10
 #define AIGPROP_UNSAT 20
 
+#define AIGPROP_ROOT_POS 1
+#define AIGPROP_ROOT_NEG 2
+
+#define AIGPROP_MAX_NSAMPLES 64
+
 struct AIGProp
 {
   BtorAIGMgr *amgr;
   BtorIntHashTable *roots;
   BtorIntHashTable *unsatroots;
-  BtorIntHashTable *score;
-  BtorIntHashTable *model;
-  BtorIntHashTable *parents;
+
+  /* Flat arrays indexed by AIG id, allocated for the first 'size' ids. */
+  uint32_t size;
+  int8_t *model;    /* 1 (true), -1 (false), 0 (not assigned) */
+  double *score;    /* [2 * id]: score of id, [2 * id + 1]: score of -id */
+  uint8_t *isroot;  /* AIGPROP_ROOT_POS: id is a root, AIGPROP_ROOT_NEG: -id */
+  uint32_t *pstart; /* parents of id: parents[pstart[id] .. pstart[id+1]-1] */
+  int32_t *parents;
+  uint32_t *mark; /* cone collection, marked if equal to 'stamp' */
+  uint32_t stamp;
+  uint64_t *sim; /* bit-parallel simulation of sampled moves */
+  /* ids of all AIGs in the cones of the roots, ascending (topological) */
+  BtorIntStack nodes;
+  BtorIntStack cone;
+  BtorIntStack stack;
 
   BtorRNG rng;
 
@@ -32,6 +50,8 @@ struct AIGProp
   uint32_t seed;
   uint32_t use_restarts;
   uint32_t use_bandit;
+  uint32_t nsamples;
+  uint32_t use_adaptive; /* adaptive restarts (BTOR_OPT_LS_ADAPTIVE) */
 
   struct
   {
@@ -55,13 +75,17 @@ AIGProp *aigprop_new_aigprop (BtorAIGMgr *amgr,
                               uint32_t loglevel,
                               uint32_t seed,
                               uint32_t use_restarts,
-                              uint32_t use_bandit);
+                              uint32_t use_bandit,
+                              uint32_t nsamples,
+                              uint32_t use_adaptive);
 
 AIGProp *aigprop_clone_aigprop (BtorAIGMgr *clone, AIGProp *aprop);
 void aigprop_delete_aigprop (AIGProp *aprop);
 
 int32_t aigprop_get_assignment_aig (AIGProp *aprop, BtorAIG *aig);
+bool aigprop_has_assignment_aig (AIGProp *aprop, BtorAIG *aig);
 void aigprop_generate_model (AIGProp *aprop, bool reset);
+void aigprop_delete_model (AIGProp *aprop);
 
 int32_t aigprop_sat (AIGProp *aprop, BtorIntHashTable *roots);
 
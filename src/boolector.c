@@ -624,6 +624,33 @@ boolector_reset_assumptions (Btor *btor)
 #endif
 }
 
+void
+boolector_set_phase_hint (Btor *btor, BoolectorNode *node, const char *bits)
+{
+  BtorNode *exp;
+  BtorBitVector *bv;
+
+  exp = BTOR_IMPORT_BOOLECTOR_NODE (node);
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_ABORT_ARG_NULL (exp);
+  BTOR_ABORT_ARG_NULL (bits);
+  BTOR_TRAPI_UNFUN_EXT (exp, "%s", bits);
+  BTOR_ABORT_REFS_NOT_POS (exp);
+  BTOR_ABORT_BTOR_MISMATCH (btor, exp);
+  BTOR_ABORT (!btor_node_is_regular (exp) || !btor_node_is_bv_var (exp),
+              "'node' must be a bit-vector variable");
+  BTOR_ABORT (strlen (bits) != btor_node_bv_get_width (btor, exp),
+              "length of 'bits' must match bit width of 'node'");
+  BTOR_ABORT (strspn (bits, "01") != strlen (bits),
+              "'bits' must be a binary string");
+  bv = btor_bv_char_to_bv (btor->mm, bits);
+  btor_set_phase_hint (btor, exp, bv);
+  btor_bv_free (btor->mm, bv);
+#ifndef NDEBUG
+  BTOR_CHKCLONE_NORES (set_phase_hint, BTOR_CLONED_EXP (exp), bits);
+#endif
+}
+
 /*------------------------------------------------------------------------*/
 
 int32_t
@@ -738,6 +765,21 @@ boolector_set_sat_solver (Btor *btor, const char *solver)
 #endif
 }
 
+void
+boolector_set_pp_pipeline (Btor *btor, const char *pipeline)
+{
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_TRAPI ("%s", pipeline);
+  BTOR_ABORT_ARG_NULL (pipeline);
+  BTOR_ABORT (!btor_pp_parse_pipeline (btor->mm, pipeline, 0),
+              "invalid preprocessing pipeline '%s'",
+              pipeline);
+  btor_opt_set_str (btor, BTOR_OPT_PP_PIPELINE, pipeline);
+#ifndef NDEBUG
+  BTOR_CHKCLONE_NORES (set_pp_pipeline, pipeline);
+#endif
+}
+
 /*------------------------------------------------------------------------*/
 
 void
@@ -4786,6 +4828,20 @@ boolector_parse_smt2 (Btor *btor,
   return res;
 }
 
+int32_t
+boolector_parse_lemmas_smt2 (Btor *btor,
+                             FILE *infile,
+                             const char *infile_name,
+                             char **error_msg)
+{
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_ABORT_ARG_NULL (infile);
+  BTOR_ABORT_ARG_NULL (infile_name);
+  BTOR_ABORT_ARG_NULL (error_msg);
+  /* parser uses API calls only, which are already shadowed */
+  return btor_parse_smt2_lemmas (btor, infile, infile_name, error_msg);
+}
+
 /*------------------------------------------------------------------------*/
 
 void
@@ -4871,6 +4927,15 @@ boolector_dump_smt2 (Btor *btor, FILE *file)
 #endif
 }
 
+void
+boolector_dump_lemmas_smt2 (Btor *btor, FILE *file)
+{
+  BTOR_TRAPI ("");
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_ABORT_ARG_NULL (file);
+  btor_dumpsmt_dump_lemmas (btor, file);
+}
+
 void
 boolector_dump_aiger_ascii (Btor *btor, FILE *file, bool merge_roots)
 {
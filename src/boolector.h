@@ -317,6 +317,27 @@ void boolector_fixate_assumptions (Btor *btor);
 */
 void boolector_reset_assumptions (Btor *btor);
 
+/*!
+  Set the value the SAT solver decides first for bit-vector variable
+  ``node`` on the next call to boolector_sat.
+
+  Phase hints only guide the search of the SAT solver and do not affect the
+  result. They are discarded after the next call to boolector_sat. This is
+  useful in incremental mode if a solution is expected to be close to a
+  known assignment, e.g., the previous model (see
+  BTOR_OPT_INCREMENTAL_PHASES).
+
+  :param btor: Boolector instance.
+  :param node: Bit-vector variable.
+  :param bits: The value as bit string of the bit width of ``node``.
+
+  .. seealso::
+    boolector_bv_assignment
+*/
+void boolector_set_phase_hint (Btor *btor,
+                               BoolectorNode *node,
+                               const char *bits);
+
 /*------------------------------------------------------------------------*/
 
 /*!
@@ -399,6 +420,24 @@ int32_t boolector_simplify (Btor *btor);
 */
 void boolector_set_sat_solver (Btor *btor, const char *solver);
 
+/*!
+  Set the order and subset of preprocessing passes.
+
+  ``pipeline`` is a comma separated list of pass names, which are run in the
+  given order in each rewriting round of boolector_simplify.  A pass is
+  still only run if it is enabled via its corresponding option.  The default
+  pipeline is
+  ``varsubst,embed,elimslices,bvdomains,skel,uc,extract,merge,elimapplies,``
+  ``ack,normadds,bvwidths``.
+
+  :param btor: Boolector instance.
+  :param pipeline: Comma separated list of pass names.
+
+  .. seealso::
+    boolector_simplify
+*/
+void boolector_set_pp_pipeline (Btor *btor, const char *pipeline);
+
 /*------------------------------------------------------------------------*/
 
 /*!
@@ -2434,6 +2473,32 @@ int32_t boolector_parse_smt2 (Btor *btor,
                               char **error_msg,
                               int32_t *status);
 
+/*!
+  Parse lemmas in `SMT-LIB v2`_ format as dumped via
+  boolector_dump_lemmas_smt2 and assert them.
+
+  Declared symbols are bound to the existing expressions with the same symbol
+  and sort, symbols without a matching expression are bound to fresh inputs.
+  Parsing stops at the first ``check-sat`` command.
+  Since lemmas are valid independent of the input formula, asserting them
+  does not change satisfiability, but saves the corresponding refinement
+  iterations of the function solver if they are relevant for the formula.
+
+  :param btor: Boolector instance.
+  :param infile: Input file.
+  :param infile_name: Input file name.
+  :param error_msg: Error message.
+  :return: BOOLECTOR_UNKNOWN or BOOLECTOR_PARSE_ERROR if a parse error
+           occurred.
+
+  .. seealso::
+    boolector_dump_lemmas_smt2
+*/
+int32_t boolector_parse_lemmas_smt2 (Btor *btor,
+                                     FILE *infile,
+                                     const char *infile_name,
+                                     char **error_msg);
+
 /*------------------------------------------------------------------------*/
 
 /*!
@@ -2484,6 +2549,20 @@ void boolector_dump_smt2_node (Btor *btor, FILE *file, BoolectorNode *node);
 */
 void boolector_dump_smt2 (Btor *btor, FILE *file);
 
+/*!
+  Dumps the lemmas generated by the function solver (engine ``fun``) in
+  `SMT-LIB v2`_ format, where each lemma is dumped as an assertion.
+  Lemmas over inputs without a symbol are omitted since they can not be
+  bound to the corresponding inputs when parsed again.
+
+  :param btor: Boolector instance
+  :param file: Output file.
+
+  .. seealso::
+    boolector_parse_lemmas_smt2
+*/
+void boolector_dump_lemmas_smt2 (Btor *btor, FILE *file);
+
 /*!
   Dumps bit-vector formula to file in ascii AIGER format.
 
@@ -0,0 +1,802 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2018 Aina Niemetz.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorbvprop.h"
+
+#include "btorcore.h"
+#include "btorsort.h"
+#include "utils/btorutil.h"
+
+/*------------------------------------------------------------------------*/
+
+BtorBvDomain *
+btor_bvprop_new_init (BtorMemMgr *mm, uint32_t width)
+{
+  assert (mm);
+  assert (width);
+
+  BtorBvDomain *res;
+
+  BTOR_NEW (mm, res);
+  res->lo = btor_bv_new (mm, width);
+  res->hi = btor_bv_ones (mm, width);
+  return res;
+}
+
+BtorBvDomain *
+btor_bvprop_new (BtorMemMgr *mm,
+                 const BtorBitVector *lo,
+                 const BtorBitVector *hi)
+{
+  assert (mm);
+  assert (lo);
+  assert (hi);
+  assert (btor_bv_get_width (lo) == btor_bv_get_width (hi));
+
+  BtorBvDomain *res;
+
+  BTOR_NEW (mm, res);
+  res->lo = btor_bv_copy (mm, lo);
+  res->hi = btor_bv_copy (mm, hi);
+  return res;
+}
+
+void
+btor_bvprop_free (BtorMemMgr *mm, BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+
+  btor_bv_free (mm, d->lo);
+  btor_bv_free (mm, d->hi);
+  BTOR_DELETE (mm, d);
+}
+
+/* Check if there are bits fixed to 1 in 'lo1' and fixed to 0 in 'hi2'. */
+static bool
+has_conflicting_bits (BtorMemMgr *mm,
+                      const BtorBitVector *lo1,
+                      const BtorBitVector *hi2)
+{
+  bool res;
+  BtorBitVector *not_hi, *and;
+
+  not_hi = btor_bv_not (mm, hi2);
+  and    = btor_bv_and (mm, lo1, not_hi);
+  res    = !btor_bv_is_zero (and);
+  btor_bv_free (mm, not_hi);
+  btor_bv_free (mm, and);
+  return res;
+}
+
+bool
+btor_bvprop_is_valid (BtorMemMgr *mm, const BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+  return !has_conflicting_bits (mm, d->lo, d->hi);
+}
+
+bool
+btor_bvprop_is_fixed (BtorMemMgr *mm, const BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+  (void) mm;
+  return btor_bv_compare (d->lo, d->hi) == 0;
+}
+
+bool
+btor_bvprop_has_fixed_bits (BtorMemMgr *mm, const BtorBvDomain *d)
+{
+  assert (mm);
+  assert (d);
+  (void) mm;
+  return !btor_bv_is_zero (d->lo) || !btor_bv_is_ones (d->hi);
+}
+
+/*------------------------------------------------------------------------*/
+
+struct BtorBvPropCtx
+{
+  Btor *btor;
+  BtorMemMgr *mm;
+  BtorIntHashTable *domains;
+  BtorIntHashTable *changed; /* nodes refined in the current round */
+  BtorIntHashTable *prev;    /* nodes refined in the previous round */
+  bool conflict;
+};
+typedef struct BtorBvPropCtx BtorBvPropCtx;
+
+static inline int32_t
+real_id (BtorNode *exp)
+{
+  return btor_node_real_addr (exp)->id;
+}
+
+static BtorBvDomain *
+get_domain (BtorIntHashTable *domains, BtorNode *exp)
+{
+  BtorHashTableData *d;
+
+  d = btor_hashint_map_get (domains, real_id (exp));
+  return d ? d->as_ptr : 0;
+}
+
+/* Get the domain of edge 'exp' (inverted if 'exp' is inverted), all bits
+ * are unconstrained if 'exp' has no domain. */
+static void
+get_edge_bits (BtorBvPropCtx *ctx,
+               BtorNode *exp,
+               BtorBitVector **lo,
+               BtorBitVector **hi)
+{
+  BtorBvDomain *d;
+
+  d = get_domain (ctx->domains, exp);
+  if (!d)
+  {
+    *lo = btor_bv_new (ctx->mm, btor_node_bv_get_width (ctx->btor, exp));
+    *hi = btor_bv_ones (ctx->mm, btor_node_bv_get_width (ctx->btor, exp));
+  }
+  else if (btor_node_is_inverted (exp))
+  {
+    *lo = btor_bv_not (ctx->mm, d->hi);
+    *hi = btor_bv_not (ctx->mm, d->lo);
+  }
+  else
+  {
+    *lo = btor_bv_copy (ctx->mm, d->lo);
+    *hi = btor_bv_copy (ctx->mm, d->hi);
+  }
+}
+
+static bool
+is_fixed_bits (const BtorBitVector *lo, const BtorBitVector *hi)
+{
+  return btor_bv_compare (lo, hi) == 0;
+}
+
+/* Intersect the domain of edge 'exp' with 'lo' and 'hi' (takes ownership of
+ * 'lo' and 'hi'). */
+static void
+refine (BtorBvPropCtx *ctx, BtorNode *exp, BtorBitVector *lo, BtorBitVector *hi)
+{
+  BtorMemMgr *mm;
+  BtorBvDomain *d;
+  BtorBitVector *tmp, *nlo, *nhi;
+
+  mm = ctx->mm;
+  d  = get_domain (ctx->domains, exp);
+  if (d)
+  {
+    if (btor_node_is_inverted (exp))
+    {
+      tmp = btor_bv_not (mm, hi);
+      btor_bv_free (mm, hi);
+      hi = btor_bv_not (mm, lo);
+      btor_bv_free (mm, lo);
+      lo = tmp;
+    }
+    nlo = btor_bv_or (mm, d->lo, lo);
+    nhi = btor_bv_and (mm, d->hi, hi);
+    if (btor_bv_compare (nlo, d->lo) || btor_bv_compare (nhi, d->hi))
+    {
+      btor_bv_free (mm, d->lo);
+      btor_bv_free (mm, d->hi);
+      d->lo = nlo;
+      d->hi = nhi;
+      if (!btor_hashint_table_contains (ctx->changed, real_id (exp)))
+        btor_hashint_table_add (ctx->changed, real_id (exp));
+      if (has_conflicting_bits (mm, nlo, nhi)) ctx->conflict = true;
+    }
+    else
+    {
+      btor_bv_free (mm, nlo);
+      btor_bv_free (mm, nhi);
+    }
+  }
+  btor_bv_free (mm, lo);
+  btor_bv_free (mm, hi);
+}
+
+/* Check if the domains given as 'lo1', 'hi1' and 'lo2', 'hi2' have no
+ * common value. */
+static bool
+is_disjoint (BtorMemMgr *mm,
+             const BtorBitVector *lo1,
+             const BtorBitVector *hi1,
+             const BtorBitVector *lo2,
+             const BtorBitVector *hi2)
+{
+  return has_conflicting_bits (mm, lo1, hi2)
+         || has_conflicting_bits (mm, lo2, hi1);
+}
+
+static bool
+get_fixed_shift (const BtorBitVector *lo,
+                 const BtorBitVector *hi,
+                 uint64_t *res)
+{
+  uint32_t width, zeroes, i;
+
+  if (!is_fixed_bits (lo, hi)) return false;
+  width = btor_bv_get_width (lo);
+  if (width <= 64)
+  {
+    *res = btor_bv_to_uint64 (lo);
+    return true;
+  }
+  zeroes = btor_bv_get_num_leading_zeros (lo);
+  if (zeroes < width - 64) return false;
+  for (i = 0, *res = 0; i < 64; i++)
+    *res |= (uint64_t) btor_bv_get_bit (lo, i) << i;
+  return true;
+}
+
+/* Ripple-carry propagation over the bits of 'x + y = z' (both directions). */
+static void
+propagate_add (BtorBvPropCtx *ctx, BtorNode *exp)
+{
+  bool xk, yk, zk, ck;
+  uint32_t i, width, xv, yv, zv, cv;
+  BtorBitVector *xlo, *xhi, *ylo, *yhi, *zlo, *zhi;
+
+  width = btor_node_bv_get_width (ctx->btor, exp);
+  get_edge_bits (ctx, exp->e[0], &xlo, &xhi);
+  get_edge_bits (ctx, exp->e[1], &ylo, &yhi);
+  get_edge_bits (ctx, exp, &zlo, &zhi);
+
+  for (i = 0, ck = true, cv = 0; i < width; i++)
+  {
+    xv = btor_bv_get_bit (xlo, i);
+    xk = xv || !btor_bv_get_bit (xhi, i);
+    yv = btor_bv_get_bit (ylo, i);
+    yk = yv || !btor_bv_get_bit (yhi, i);
+    zv = btor_bv_get_bit (zlo, i);
+    zk = zv || !btor_bv_get_bit (zhi, i);
+
+    if (ck)
+    {
+      if (xk && yk)
+      {
+        if (zk && zv != (xv ^ yv ^ cv)) ctx->conflict = true;
+        zv = xv ^ yv ^ cv;
+        zk = true;
+        btor_bv_set_bit (zlo, i, zv);
+        btor_bv_set_bit (zhi, i, zv);
+      }
+      else if (xk && zk)
+      {
+        yv = zv ^ xv ^ cv;
+        yk = true;
+        btor_bv_set_bit (ylo, i, yv);
+        btor_bv_set_bit (yhi, i, yv);
+      }
+      else if (yk && zk)
+      {
+        xv = zv ^ yv ^ cv;
+        xk = true;
+        btor_bv_set_bit (xlo, i, xv);
+        btor_bv_set_bit (xhi, i, xv);
+      }
+    }
+
+    /* carry out is known if at least two of x, y and carry in are known
+     * and equal, or all of them are known */
+    if (xk && yk && ck)
+      cv = (xv & yv) | (xv & cv) | (yv & cv);
+    else if (xk && yk && xv == yv)
+      cv = xv, ck = true;
+    else if (xk && ck && xv == cv)
+      ck = true;
+    else if (yk && ck && yv == cv)
+      ck = true;
+    else
+      ck = false;
+  }
+
+  refine (ctx, exp->e[0], xlo, xhi);
+  refine (ctx, exp->e[1], ylo, yhi);
+  refine (ctx, exp, zlo, zhi);
+}
+
+/* Propagate domains of 'exp' to its children and vice versa. */
+static void
+propagate (BtorBvPropCtx *ctx, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t i, width, w0, upper, lower;
+  uint64_t shift;
+  BtorMemMgr *mm;
+  BtorBitVector *lo[3], *hi[3], *zlo, *zhi, *tmp, *tmp2, *ones, *zero;
+
+  if (exp->kind == BTOR_BV_ADD_NODE)
+  {
+    propagate_add (ctx, exp);
+    return;
+  }
+
+  mm    = ctx->mm;
+  width = btor_node_bv_get_width (ctx->btor, exp);
+  for (i = 0; i < exp->arity; i++)
+    get_edge_bits (ctx, exp->e[i], &lo[i], &hi[i]);
+  get_edge_bits (ctx, exp, &zlo, &zhi);
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_AND_NODE:
+      refine (ctx,
+              exp,
+              btor_bv_and (mm, lo[0], lo[1]),
+              btor_bv_and (mm, hi[0], hi[1]));
+      /* bits fixed to 1 in the result are 1 in both operands, bits fixed
+       * to 0 in the result are 0 in one operand if 1 in the other */
+      for (i = 0; i < 2; i++)
+      {
+        tmp  = btor_bv_not (mm, zhi);
+        tmp2 = btor_bv_and (mm, tmp, lo[1 - i]);
+        btor_bv_free (mm, tmp);
+        refine (ctx,
+                exp->e[i],
+                btor_bv_copy (mm, zlo),
+                btor_bv_not (mm, tmp2));
+        btor_bv_free (mm, tmp2);
+      }
+      break;
+
+    case BTOR_BV_EQ_NODE:
+      if (is_disjoint (mm, lo[0], hi[0], lo[1], hi[1]))
+        refine (ctx, exp, btor_bv_new (mm, 1), btor_bv_new (mm, 1));
+      else if (is_fixed_bits (lo[0], hi[0]) && is_fixed_bits (lo[1], hi[1]))
+        refine (ctx, exp, btor_bv_one (mm, 1), btor_bv_one (mm, 1));
+      else if (btor_bv_is_one (zlo))
+      {
+        refine (ctx,
+                exp->e[0],
+                btor_bv_copy (mm, lo[1]),
+                btor_bv_copy (mm, hi[1]));
+        refine (ctx,
+                exp->e[1],
+                btor_bv_copy (mm, lo[0]),
+                btor_bv_copy (mm, hi[0]));
+      }
+      break;
+
+    case BTOR_BV_ULT_NODE:
+      w0 = btor_bv_get_width (lo[0]);
+      if (btor_bv_compare (hi[0], lo[1]) < 0)
+        refine (ctx, exp, btor_bv_one (mm, 1), btor_bv_one (mm, 1));
+      else if (btor_bv_compare (lo[0], hi[1]) >= 0)
+        refine (ctx, exp, btor_bv_new (mm, 1), btor_bv_new (mm, 1));
+      else if (btor_bv_is_one (zlo))
+      {
+        /* e[0] < max(e[1]): leading bits of max(e[1]) - 1 that are zero are
+         * zero in e[0] */
+        tmp  = btor_bv_dec (mm, hi[1]);
+        ones = btor_bv_ones (mm, w0);
+        refine (ctx,
+                exp->e[0],
+                btor_bv_new (mm, w0),
+                btor_bv_srl_uint64 (
+                    mm, ones, btor_bv_get_num_leading_zeros (tmp)));
+        btor_bv_free (mm, ones);
+        btor_bv_free (mm, tmp);
+      }
+      else if (btor_bv_is_zero (zhi))
+      {
+        /* e[1] <= max(e[0]) */
+        ones = btor_bv_ones (mm, w0);
+        refine (ctx,
+                exp->e[1],
+                btor_bv_new (mm, w0),
+                btor_bv_srl_uint64 (
+                    mm, ones, btor_bv_get_num_leading_zeros (hi[0])));
+        btor_bv_free (mm, ones);
+      }
+      break;
+
+    case BTOR_BV_MUL_NODE:
+      if (is_fixed_bits (lo[0], hi[0]) && is_fixed_bits (lo[1], hi[1]))
+      {
+        tmp = btor_bv_mul (mm, lo[0], lo[1]);
+        refine (ctx, exp, btor_bv_copy (mm, tmp), tmp);
+        break;
+      }
+      /* trailing zeros of the operands are trailing zeros of the result */
+      shift = (uint64_t) btor_bv_get_num_trailing_zeros (hi[0])
+              + btor_bv_get_num_trailing_zeros (hi[1]);
+      if (shift)
+      {
+        ones = btor_bv_ones (mm, width);
+        refine (ctx,
+                exp,
+                btor_bv_new (mm, width),
+                btor_bv_sll_uint64 (mm, ones, shift));
+        btor_bv_free (mm, ones);
+      }
+      /* odd result implies odd operands */
+      if (btor_bv_get_bit (zlo, 0))
+      {
+        for (i = 0; i < 2; i++)
+          refine (ctx,
+                  exp->e[i],
+                  btor_bv_one (mm, width),
+                  btor_bv_ones (mm, width));
+      }
+      break;
+
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+      if (is_fixed_bits (lo[0], hi[0]) && is_fixed_bits (lo[1], hi[1]))
+      {
+        tmp = exp->kind == BTOR_BV_UDIV_NODE ? btor_bv_udiv (mm, lo[0], lo[1])
+                                             : btor_bv_urem (mm, lo[0], lo[1]);
+        refine (ctx, exp, btor_bv_copy (mm, tmp), tmp);
+      }
+      break;
+
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+      if (!get_fixed_shift (lo[1], hi[1], &shift)) break;
+      if (exp->kind == BTOR_BV_SLL_NODE)
+      {
+        refine (ctx,
+                exp,
+                btor_bv_sll_uint64 (mm, lo[0], shift),
+                btor_bv_sll_uint64 (mm, hi[0], shift));
+        if (shift >= width) break;
+        /* shifted out bits are unconstrained */
+        ones = btor_bv_ones (mm, width);
+        tmp  = btor_bv_sll_uint64 (mm, ones, width - shift);
+        tmp2 = btor_bv_srl_uint64 (mm, zhi, shift);
+        refine (ctx,
+                exp->e[0],
+                btor_bv_srl_uint64 (mm, zlo, shift),
+                btor_bv_or (mm, tmp, tmp2));
+      }
+      else
+      {
+        refine (ctx,
+                exp,
+                btor_bv_srl_uint64 (mm, lo[0], shift),
+                btor_bv_srl_uint64 (mm, hi[0], shift));
+        if (shift >= width) break;
+        ones = btor_bv_ones (mm, width);
+        tmp  = btor_bv_srl_uint64 (mm, ones, width - shift);
+        tmp2 = btor_bv_sll_uint64 (mm, zhi, shift);
+        refine (ctx,
+                exp->e[0],
+                btor_bv_sll_uint64 (mm, zlo, shift),
+                btor_bv_or (mm, tmp, tmp2));
+      }
+      btor_bv_free (mm, ones);
+      btor_bv_free (mm, tmp);
+      btor_bv_free (mm, tmp2);
+      break;
+
+    case BTOR_BV_CONCAT_NODE:
+      refine (ctx,
+              exp,
+              btor_bv_concat (mm, lo[0], lo[1]),
+              btor_bv_concat (mm, hi[0], hi[1]));
+      w0 = btor_bv_get_width (lo[1]);
+      refine (ctx,
+              exp->e[0],
+              btor_bv_slice (mm, zlo, width - 1, w0),
+              btor_bv_slice (mm, zhi, width - 1, w0));
+      refine (ctx,
+              exp->e[1],
+              btor_bv_slice (mm, zlo, w0 - 1, 0),
+              btor_bv_slice (mm, zhi, w0 - 1, 0));
+      break;
+
+    case BTOR_BV_SLICE_NODE:
+      upper = btor_node_bv_slice_get_upper (exp);
+      lower = btor_node_bv_slice_get_lower (exp);
+      w0    = btor_bv_get_width (lo[0]);
+      refine (ctx,
+              exp,
+              btor_bv_slice (mm, lo[0], upper, lower),
+              btor_bv_slice (mm, hi[0], upper, lower));
+      /* bits of e[0] outside of [upper:lower] are unconstrained */
+      ones = btor_bv_ones (mm, width);
+      tmp  = btor_bv_uext (mm, ones, w0 - width);
+      tmp2 = btor_bv_sll_uint64 (mm, tmp, lower);
+      btor_bv_free (mm, tmp);
+      btor_bv_free (mm, ones);
+      ones = btor_bv_not (mm, tmp2); /* mask of unconstrained bits */
+      btor_bv_free (mm, tmp2);
+      tmp  = btor_bv_uext (mm, zhi, w0 - width);
+      tmp2 = btor_bv_sll_uint64 (mm, tmp, lower);
+      btor_bv_free (mm, tmp);
+      tmp = btor_bv_uext (mm, zlo, w0 - width);
+      refine (ctx,
+              exp->e[0],
+              btor_bv_sll_uint64 (mm, tmp, lower),
+              btor_bv_or (mm, tmp2, ones));
+      btor_bv_free (mm, tmp);
+      btor_bv_free (mm, tmp2);
+      btor_bv_free (mm, ones);
+      break;
+
+    case BTOR_COND_NODE:
+      if (btor_bv_is_one (lo[0]))
+      {
+        refine (ctx, exp, btor_bv_copy (mm, lo[1]), btor_bv_copy (mm, hi[1]));
+        refine (ctx, exp->e[1], btor_bv_copy (mm, zlo), btor_bv_copy (mm, zhi));
+      }
+      else if (btor_bv_is_zero (hi[0]))
+      {
+        refine (ctx, exp, btor_bv_copy (mm, lo[2]), btor_bv_copy (mm, hi[2]));
+        refine (ctx, exp->e[2], btor_bv_copy (mm, zlo), btor_bv_copy (mm, zhi));
+      }
+      else
+      {
+        refine (ctx,
+                exp,
+                btor_bv_and (mm, lo[1], lo[2]),
+                btor_bv_or (mm, hi[1], hi[2]));
+        /* a branch that is incompatible with the result is disabled */
+        zero = btor_bv_new (mm, 1);
+        if (is_disjoint (mm, lo[1], hi[1], zlo, zhi))
+          refine (ctx,
+                  exp->e[0],
+                  btor_bv_copy (mm, zero),
+                  btor_bv_copy (mm, zero));
+        if (is_disjoint (mm, lo[2], hi[2], zlo, zhi))
+          refine (ctx, exp->e[0], btor_bv_one (mm, 1), btor_bv_one (mm, 1));
+        btor_bv_free (mm, zero);
+      }
+      break;
+
+    default: break;
+  }
+
+  for (i = 0; i < exp->arity; i++)
+  {
+    btor_bv_free (mm, lo[i]);
+    btor_bv_free (mm, hi[i]);
+  }
+  btor_bv_free (mm, zlo);
+  btor_bv_free (mm, zhi);
+}
+
+/* Check if 'exp' or one of its children has been refined since 'exp' has
+ * been visited in the previous round. */
+static bool
+is_dirty (BtorBvPropCtx *ctx, BtorNode *exp)
+{
+  uint32_t i;
+  int32_t id;
+
+  for (i = 0; i <= exp->arity; i++)
+  {
+    id = real_id (i ? exp->e[i - 1] : exp);
+    if (btor_hashint_table_contains (ctx->prev, id)
+        || btor_hashint_table_contains (ctx->changed, id))
+      return true;
+  }
+  return false;
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+has_domain (Btor *btor, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+  return !exp->parameterized && btor_sort_is_bv (btor, exp->sort_id);
+}
+
+/* Check if the domains of the children of 'exp' are propagated. */
+static bool
+is_propagated (Btor *btor, BtorNode *exp)
+{
+  uint32_t i;
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_CONCAT_NODE:
+    case BTOR_BV_SLICE_NODE:
+    case BTOR_COND_NODE:
+      for (i = 0; i < exp->arity; i++)
+        if (!has_domain (btor, btor_node_real_addr (exp->e[i]))) return false;
+      return true;
+    default: return false;
+  }
+}
+
+BtorIntHashTable *
+btor_bvprop_compute_domains (Btor *btor, uint32_t max_rounds)
+{
+  assert (btor);
+
+  uint32_t i, j, rounds;
+  BtorNode *cur;
+  BtorNodePtrStack stack, nodes;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *cache;
+  BtorBvPropCtx ctx;
+  BtorMemMgr *mm;
+  BtorBitVector *bits;
+
+  mm           = btor->mm;
+  ctx.btor     = btor;
+  ctx.mm       = mm;
+  ctx.domains  = btor_hashint_map_new (mm);
+  ctx.changed  = btor_hashint_table_new (mm);
+  ctx.prev     = 0;
+  ctx.conflict = false;
+
+  /* collect bit-vector nodes in the cone of the roots */
+  BTOR_INIT_STACK (mm, stack);
+  BTOR_INIT_STACK (mm, nodes);
+  cache = btor_hashint_table_new (mm);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (stack, btor_iter_hashptr_next (&it));
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (stack));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    for (j = 0; j < cur->arity; j++) BTOR_PUSH_STACK (stack, cur->e[j]);
+    if (!has_domain (btor, cur)) continue;
+    if (btor_node_is_bv_const (cur))
+    {
+      bits = btor_node_bv_const_get_bits (cur);
+      btor_hashint_map_add (ctx.domains, cur->id)->as_ptr =
+          btor_bvprop_new (mm, bits, bits);
+      continue;
+    }
+    btor_hashint_map_add (ctx.domains, cur->id)->as_ptr =
+        btor_bvprop_new_init (mm, btor_node_bv_get_width (btor, cur));
+    if (is_propagated (btor, cur)) BTOR_PUSH_STACK (nodes, cur);
+  }
+  btor_hashint_table_delete (cache);
+  qsort (nodes.start,
+         BTOR_COUNT_STACK (nodes),
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+
+  /* roots are fixed to true */
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    refine (&ctx, cur, btor_bv_one (mm, 1), btor_bv_one (mm, 1));
+  }
+
+  /* forward (bottom-up) and backward (top-down) sweeps until fixpoint,
+   * after the first round only nodes adjacent to refined nodes are visited */
+  rounds = 0;
+  do
+  {
+    if (ctx.prev) btor_hashint_table_delete (ctx.prev);
+    ctx.prev    = ctx.changed;
+    ctx.changed = btor_hashint_table_new (mm);
+    for (i = 0; !ctx.conflict && i < BTOR_COUNT_STACK (nodes); i++)
+    {
+      cur = BTOR_PEEK_STACK (nodes, i);
+      if (!rounds || is_dirty (&ctx, cur)) propagate (&ctx, cur);
+    }
+    for (i = BTOR_COUNT_STACK (nodes); !ctx.conflict && i > 0; i--)
+    {
+      cur = BTOR_PEEK_STACK (nodes, i - 1);
+      if (!rounds || is_dirty (&ctx, cur)) propagate (&ctx, cur);
+    }
+    rounds += 1;
+  } while (ctx.changed->count && !ctx.conflict && rounds < max_rounds);
+  btor_hashint_table_delete (ctx.prev);
+  btor_hashint_table_delete (ctx.changed);
+
+  BTOR_RELEASE_STACK (stack);
+  BTOR_RELEASE_STACK (nodes);
+
+  BTOR_MSG (btor->msg,
+            1,
+            "computed fixed-bit domains of %u nodes in %u rounds%s",
+            ctx.domains->count,
+            rounds,
+            ctx.conflict ? " (inconsistent)" : "");
+
+  if (ctx.conflict)
+  {
+    btor_bvprop_delete_domains (btor, ctx.domains);
+    return 0;
+  }
+  return ctx.domains;
+}
+
+void
+btor_bvprop_delete_domains (Btor *btor, BtorIntHashTable *domains)
+{
+  assert (btor);
+  assert (domains);
+
+  size_t i;
+
+  for (i = 0; i < domains->size; i++)
+  {
+    if (!domains->keys[i]) continue;
+    btor_bvprop_free (btor->mm, domains->data[i].as_ptr);
+  }
+  btor_hashint_map_delete (domains);
+}
+
+BtorBvDomain *
+btor_bvprop_get_domain (BtorMemMgr *mm,
+                        BtorIntHashTable *domains,
+                        BtorNode *exp)
+{
+  assert (mm);
+  assert (domains);
+  assert (exp);
+
+  BtorBvDomain *d, *res;
+
+  d = get_domain (domains, exp);
+  if (!d) return 0;
+  BTOR_NEW (mm, res);
+  if (btor_node_is_inverted (exp))
+  {
+    res->lo = btor_bv_not (mm, d->hi);
+    res->hi = btor_bv_not (mm, d->lo);
+  }
+  else
+  {
+    res->lo = btor_bv_copy (mm, d->lo);
+    res->hi = btor_bv_copy (mm, d->hi);
+  }
+  return res;
+}
+
+BtorBitVector *
+btor_bvprop_fix_bits (BtorMemMgr *mm,
+                      BtorIntHashTable *domains,
+                      BtorNode *exp,
+                      const BtorBitVector *bv)
+{
+  assert (mm);
+  assert (domains);
+  assert (exp);
+  assert (bv);
+
+  BtorBvDomain *d;
+  BtorBitVector *res, *tmp;
+
+  d = btor_bvprop_get_domain (mm, domains, exp);
+  if (!d) return 0;
+  assert (btor_bv_get_width (d->lo) == btor_bv_get_width (bv));
+
+  tmp = btor_bv_and (mm, bv, d->hi);
+  res = btor_bv_or (mm, tmp, d->lo);
+  btor_bv_free (mm, tmp);
+  btor_bvprop_free (mm, d);
+  if (!btor_bv_compare (res, bv))
+  {
+    btor_bv_free (mm, res);
+    return 0;
+  }
+  return res;
+}
@@ -0,0 +1,84 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2018 Aina Niemetz.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORBVPROP_H_INCLUDED
+#define BTORBVPROP_H_INCLUDED
+
+#include "btorbv.h"
+#include "btornode.h"
+#include "btortypes.h"
+#include "utils/btorhashint.h"
+#include "utils/btormem.h"
+
+/**
+ * Fixed-bit domain of a bit-vector node.
+ * A bit that is 1 in 'lo' is fixed to 1, a bit that is 0 in 'hi' is fixed to
+ * 0, all other bits are unconstrained. A domain is valid if lo <= hi
+ * bit-wise, i.e., no bit is fixed to both 0 and 1.
+ */
+struct BtorBvDomain
+{
+  BtorBitVector *lo;
+  BtorBitVector *hi;
+};
+typedef struct BtorBvDomain BtorBvDomain;
+
+/* Create a new domain with all bits unconstrained. */
+BtorBvDomain *btor_bvprop_new_init (BtorMemMgr *mm, uint32_t width);
+
+/* Create a new domain with copies of 'lo' and 'hi'. */
+BtorBvDomain *btor_bvprop_new (BtorMemMgr *mm,
+                               const BtorBitVector *lo,
+                               const BtorBitVector *hi);
+
+void btor_bvprop_free (BtorMemMgr *mm, BtorBvDomain *d);
+
+/* Check if no bit of 'd' is fixed to both 0 and 1. */
+bool btor_bvprop_is_valid (BtorMemMgr *mm, const BtorBvDomain *d);
+
+/* Check if all bits of 'd' are fixed. */
+bool btor_bvprop_is_fixed (BtorMemMgr *mm, const BtorBvDomain *d);
+
+/* Check if at least one bit of 'd' is fixed. */
+bool btor_bvprop_has_fixed_bits (BtorMemMgr *mm, const BtorBvDomain *d);
+
+/*------------------------------------------------------------------------*/
+
+/**
+ * Compute fixed-bit domains of all bit-vector nodes in the cone of the
+ * current constraints and assumptions (which are fixed to true) by means of
+ * forward and backward constant bit propagation, until a fixpoint is reached
+ * or at most 'max_rounds' rounds have been performed.
+ *
+ * Returns a map from node ids to domains (as_ptr), or 0 if the constraints
+ * were found to be inconsistent.
+ */
+BtorIntHashTable *btor_bvprop_compute_domains (Btor *btor,
+                                               uint32_t max_rounds);
+
+void btor_bvprop_delete_domains (Btor *btor, BtorIntHashTable *domains);
+
+/**
+ * Get a copy of the domain of (possibly inverted) node 'exp', or 0 if 'exp'
+ * has no domain.
+ */
+BtorBvDomain *btor_bvprop_get_domain (BtorMemMgr *mm,
+                                      BtorIntHashTable *domains,
+                                      BtorNode *exp);
+
+/**
+ * Fix the bits of assignment 'bv' of (possibly inverted) node 'exp' that are
+ * fixed by the domain of 'exp'.
+ * Returns 0 if 'bv' already respects the domain of 'exp'.
+ */
+BtorBitVector *btor_bvprop_fix_bits (BtorMemMgr *mm,
+                                     BtorIntHashTable *domains,
+                                     BtorNode *exp,
+                                     const BtorBitVector *bv);
+
+#endif
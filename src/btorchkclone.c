@@ -228,6 +228,7 @@ chkclone_stats (Btor *btor, Btor *clone)
   assert (btor);
   assert (clone);
 
+  uint32_t i;
 #ifndef NDEBUG
   BtorPtrHashTableIterator it, cit;
   BtorHashTableData *data, *cdata;
@@ -250,6 +251,17 @@ chkclone_stats (Btor *btor, Btor *clone)
   BTOR_CHKCLONE_STATS (bv_uc_props);
   BTOR_CHKCLONE_STATS (fun_uc_props);
   BTOR_CHKCLONE_STATS (lambdas_merged);
+  BTOR_CHKCLONE_STATS (bv_domain_vars);
+  BTOR_CHKCLONE_STATS (bv_domain_bits);
+  BTOR_CHKCLONE_STATS (bv_domain_terms);
+  BTOR_CHKCLONE_STATS (bv_width_terms);
+  BTOR_CHKCLONE_STATS (bv_width_bits);
+  for (i = 0; i < BTOR_PP_NUM_PASSES; i++)
+  {
+    BTOR_CHKCLONE_STATS (pp_passes[i].runs);
+    BTOR_CHKCLONE_STATS (pp_passes[i].nodes_before);
+    BTOR_CHKCLONE_STATS (pp_passes[i].nodes_after);
+  }
   BTOR_CHKCLONE_STATS (expressions);
   BTOR_CHKCLONE_STATS (clone_calls);
   BTOR_CHKCLONE_STATS (node_bytes_alloc);
@@ -1154,6 +1166,8 @@ chkclone_slv (Btor *btor, Btor *clone)
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, move_gw_rand);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, move_gw_rand_walk);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, updates);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, noise_inc);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, noise_dec);
   }
   else if (btor->slv->kind == BTOR_PROP_SOLVER_KIND)
   {
@@ -1173,8 +1187,11 @@ chkclone_slv (Btor *btor, Btor *clone)
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, non_rec_conf);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, props);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, props_inv);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, props_dom);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, props_cons);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, updates);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, noise_inc);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, noise_dec);
 #ifndef NDEBUG
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, inv_add);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, inv_and);
@@ -1211,15 +1228,21 @@ chkclone_slv (Btor *btor, Btor *clone)
 
     chkclone_int_hash_map (
         slv->aprop->unsatroots, cslv->aprop->unsatroots, cmp_data_as_int);
-    chkclone_int_hash_map (
-        slv->aprop->model, cslv->aprop->model, cmp_data_as_int);
-    chkclone_int_hash_map (
-        slv->aprop->score, cslv->aprop->score, cmp_data_as_dbl);
+    assert (slv->aprop->size == cslv->aprop->size);
+    assert (!slv->aprop->model == !cslv->aprop->model);
+    assert (!slv->aprop->model || slv->aprop->model != cslv->aprop->model);
+    assert (!slv->aprop->model
+            || !memcmp (slv->aprop->model,
+                        cslv->aprop->model,
+                        slv->aprop->size * sizeof (*slv->aprop->model)));
+    assert (!slv->aprop->score && !cslv->aprop->score);
 
     BTOR_CHKCLONE_SLV_STATE (slv->aprop, cslv->aprop, loglevel);
     BTOR_CHKCLONE_SLV_STATE (slv->aprop, cslv->aprop, seed);
     BTOR_CHKCLONE_SLV_STATE (slv->aprop, cslv->aprop, use_restarts);
     BTOR_CHKCLONE_SLV_STATE (slv->aprop, cslv->aprop, use_bandit);
+    BTOR_CHKCLONE_SLV_STATE (slv->aprop, cslv->aprop, nsamples);
+    BTOR_CHKCLONE_SLV_STATE (slv->aprop, cslv->aprop, use_adaptive);
 
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, moves);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, restarts);
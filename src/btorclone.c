@@ -909,6 +909,10 @@ clone_aux_btor (Btor *btor,
   memcpy (clone, btor, sizeof (Btor));
   clone->mm = mm;
   btor_rng_clone (&btor->rng, &clone->rng);
+  /* flat stores are not cloned, they are rebuilt on the next simplification */
+  clone->flat_stores = 0;
+  /* phase hints are not cloned, they only guide the SAT solver */
+  clone->phase_hints = 0;
 
   BTOR_CLR (&clone->cbs);
   btor_opt_clone_opts (btor, clone);
@@ -1524,11 +1528,10 @@ clone_aux_btor (Btor *btor,
       {
         assert (cslv->aprop);
         CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->roots, cslv->aprop->roots);
-        CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->score, cslv->aprop->score);
-        CHKCLONE_MEM_PTR_HASH_TABLE (slv->aprop->model, cslv->aprop->model);
         allocated += sizeof (AIGProp) + MEM_PTR_HASH_TABLE (cslv->aprop->roots)
-                     + MEM_PTR_HASH_TABLE (cslv->aprop->score)
-                     + MEM_PTR_HASH_TABLE (cslv->aprop->model);
+                     + (cslv->aprop->model ? cslv->aprop->size
+                                                 * sizeof (*cslv->aprop->model)
+                                           : 0);
       }
 
       allocated += sizeof (BtorAIGPropSolver);
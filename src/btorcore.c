@@ -32,6 +32,7 @@
 #include "btorslvquant.h"
 #include "btorslvsls.h"
 #include "btorsubst.h"
+#include "preprocess/btorflatstore.h"
 #include "preprocess/btorpreprocess.h"
 #include "preprocess/btorvarsubst.h"
 #include "utils/btorhashint.h"
@@ -498,6 +499,24 @@ btor_print_stats (Btor *btor)
   BTOR_MSG (
       btor->msg, 1, "%5d mul normalizations", btor->stats.muls_normalized);
   BTOR_MSG (btor->msg, 1, "%5lld lambdas merged", btor->stats.lambdas_merged);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d flattened write chains (%d writes, %d ranges)",
+            btor->stats.flat_stores,
+            btor->stats.flat_store_writes,
+            btor->stats.flat_store_ranges);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d variables with fixed bits (%d bits), %d fixed terms",
+            btor->stats.bv_domain_vars,
+            btor->stats.bv_domain_bits,
+            btor->stats.bv_domain_terms);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5d terms with reduced width (%d bits)",
+            btor->stats.bv_width_terms,
+            btor->stats.bv_width_bits);
+  BTOR_MSG (btor->msg, 1, "%5lld phase hints", btor->stats.phase_hints);
   BTOR_MSG (btor->msg,
             1,
             "%5d static apply propagations over lambdas",
@@ -510,6 +529,9 @@ btor_print_stats (Btor *btor)
       btor->msg, 1, "%5lld beta reductions", btor->stats.beta_reduce_calls);
   BTOR_MSG (btor->msg, 1, "%5lld clone calls", btor->stats.clone_calls);
 
+  BTOR_MSG (btor->msg, 1, "");
+  btor_pp_print_stats (btor);
+
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg, 1, "rewrite rule cache");
   BTOR_MSG (btor->msg, 1, "  %lld cached (add) ", btor->rw_cache->num_add);
@@ -648,6 +670,27 @@ btor_print_stats (Btor *btor)
               btor->time.merge,
               percent (btor->time.merge, btor->time.simplify));
 
+  if (btor_opt_get (btor, BTOR_OPT_FLATTEN_STORES))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds write chain flattening (%.0f%%)",
+              btor->time.flatstore,
+              percent (btor->time.flatstore, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_SIMP_BV_DOMAINS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds bit-vector domains (%.0f%%)",
+              btor->time.bvdomains,
+              percent (btor->time.bvdomains, btor->time.simplify));
+
+  if (btor_opt_get (btor, BTOR_OPT_SIMP_BV_WIDTHS))
+    BTOR_MSG (btor->msg,
+              1,
+              "    %.2f seconds bit-width reduction (%.0f%%)",
+              btor->time.bvwidth,
+              percent (btor->time.bvwidth, btor->time.simplify));
+
   if (btor_opt_get (btor, BTOR_OPT_BETA_REDUCE))
     BTOR_MSG (btor->msg,
               1,
@@ -905,6 +948,9 @@ btor_delete (Btor *btor)
 
   if (btor->slv) btor->slv->api.delet (btor->slv);
 
+  btor_delete_flat_stores (btor);
+  btor_delete_phase_hints (btor);
+
   if (btor->parse_error_msg) btor_mem_freestr (mm, btor->parse_error_msg);
 
   btor_ass_delete_bv_list (
@@ -1694,6 +1740,31 @@ reset_functions_with_model (Btor *btor)
   BTOR_RESET_STACK (btor->functions_with_model);
 }
 
+/* keep the model of the previous SAT call as phase hints for the next one,
+ * phase hints set by the user are not overwritten */
+static void
+add_model_phase_hints (Btor *btor)
+{
+  assert (btor);
+
+  BtorNode *var;
+  BtorHashTableData *d;
+  BtorPtrHashTableIterator it;
+
+  if (!btor->bv_model) return;
+
+  btor_iter_hashptr_init (&it, btor->bv_vars);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    var = btor_iter_hashptr_next (&it);
+    assert (btor_node_is_regular (var));
+    if (btor->phase_hints && btor_hashptr_table_get (btor->phase_hints, var))
+      continue;
+    if (!(d = btor_hashint_map_get (btor->bv_model, var->id))) continue;
+    btor_set_phase_hint (btor, var, d->as_ptr);
+  }
+}
+
 void
 btor_reset_incremental_usage (Btor *btor)
 {
@@ -1702,6 +1773,8 @@ btor_reset_incremental_usage (Btor *btor)
   btor_reset_assumptions (btor);
   reset_functions_with_model (btor);
   btor->valid_assignments = 0;
+  if (btor_opt_get (btor, BTOR_OPT_INCREMENTAL_PHASES))
+    add_model_phase_hints (btor);
   btor_model_delete (btor);
 }
 
@@ -2849,6 +2922,98 @@ btor_add_again_assumptions (Btor *btor)
   btor_hashint_table_delete (mark);
 }
 
+void
+btor_set_phase_hint (Btor *btor, BtorNode *exp, const BtorBitVector *bv)
+{
+  assert (btor);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+  assert (btor_node_is_bv_var (exp));
+  assert (bv);
+  assert (btor_node_bv_get_width (btor, exp) == btor_bv_get_width (bv));
+
+  BtorPtrHashBucket *b;
+
+  if (!btor->phase_hints)
+    btor->phase_hints =
+        btor_hashptr_table_new (btor->mm,
+                                (BtorHashPtr) btor_node_hash_by_id,
+                                (BtorCmpPtr) btor_node_compare_by_id);
+
+  if ((b = btor_hashptr_table_get (btor->phase_hints, exp)))
+    btor_bv_free (btor->mm, b->data.as_ptr);
+  else
+    b = btor_hashptr_table_add (btor->phase_hints, btor_node_copy (btor, exp));
+  b->data.as_ptr = btor_bv_copy (btor->mm, bv);
+}
+
+/* forward phase hints to the SAT solver, hints only apply to the next SAT
+ * call and are discarded afterwards */
+void
+btor_add_phase_hints (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, width;
+  int32_t lit;
+  bool inv;
+  BtorNode *exp, *real_exp;
+  BtorBitVector *bv;
+  BtorAIGVec *av;
+  BtorSATMgr *smgr;
+  BtorPtrHashTableIterator it;
+
+  if (!btor->phase_hints) return;
+
+  smgr = btor_get_sat_mgr (btor);
+  if (btor_sat_is_initialized (smgr))
+  {
+    btor_iter_hashptr_init (&it, btor->phase_hints);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      bv       = it.bucket->data.as_ptr;
+      exp      = btor_simplify_exp (btor, btor_iter_hashptr_next (&it));
+      real_exp = btor_node_real_addr (exp);
+      /* variable was substituted or does not occur in the bit-blasted
+       * formula */
+      if (!btor_node_is_bv_var (real_exp) || !real_exp->av) continue;
+      inv   = btor_node_is_inverted (exp);
+      av    = real_exp->av;
+      width = av->width;
+      assert (width == btor_bv_get_width (bv));
+      for (i = 0; i < width; i++)
+      {
+        if (btor_aig_is_const (av->aigs[i])) continue;
+        lit = btor_aig_get_cnf_id (av->aigs[i]);
+        if (!lit) continue;
+        if (btor_bv_get_bit (bv, width - 1 - i) == inv) lit = -lit;
+        btor_sat_phase (smgr, lit);
+        btor->stats.phase_hints += 1;
+      }
+    }
+  }
+  btor_delete_phase_hints (btor);
+}
+
+void
+btor_delete_phase_hints (Btor *btor)
+{
+  assert (btor);
+
+  BtorPtrHashTableIterator it;
+
+  if (!btor->phase_hints) return;
+
+  btor_iter_hashptr_init (&it, btor->phase_hints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    btor_bv_free (btor->mm, it.bucket->data.as_ptr);
+    btor_node_release (btor, btor_iter_hashptr_next (&it));
+  }
+  btor_hashptr_table_delete (btor->phase_hints);
+  btor->phase_hints = 0;
+}
+
 #if 0
 /* updates SAT assignments, reads assumptions and
  * returns if an assignment has changed
@@ -3038,6 +3203,9 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
   btor->last_sat_result = res;
   btor->btor_sat_btor_called++;
   btor->valid_assignments = 1;
+  /* phase hints only apply to this call (if they were not already consumed by
+   * the solver) */
+  btor_delete_phase_hints (btor);
 
   if (btor_opt_get (btor, BTOR_OPT_MODEL_GEN) && res == BTOR_RESULT_SAT)
   {
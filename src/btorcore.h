@@ -20,6 +20,7 @@
 #include "btorsat.h"
 #include "btorslv.h"
 #include "btorsort.h"
+#include "preprocess/btorpreprocess.h"
 #include "btortypes.h"
 #include "utils/btorhashint.h"
 #include "utils/btormem.h"
@@ -117,6 +118,13 @@ struct Btor
 
   BtorPtrHashTable *substitutions;
 
+  /* maps writes to flattened chains of constant-index writes */
+  BtorIntHashTable *flat_stores;
+
+  /* maps bit-vector variables to the values the SAT solver is supposed to
+   * decide first on the next SAT call (created on demand) */
+  BtorPtrHashTable *phase_hints;
+
   BtorNode *true_exp;
 
   BtorIntHashTable *bv_model;
@@ -200,6 +208,21 @@ struct Btor
     uint32_t fun_uc_props;
     uint32_t param_uc_props;
     uint_least64_t lambdas_merged;
+    uint32_t flat_stores;       /* number of flattened write chains */
+    uint32_t flat_store_writes; /* number of writes in flattened chains */
+    uint32_t flat_store_ranges; /* number of range writes in flat chains */
+    uint32_t bv_domain_vars;    /* number of vars with fixed bits */
+    uint32_t bv_domain_bits;    /* number of fixed bits of vars */
+    uint32_t bv_domain_terms;   /* number of terms fixed by domains */
+    uint32_t bv_width_terms;    /* number of terms with reduced width */
+    uint32_t bv_width_bits;     /* number of bits removed from terms */
+    uint_least64_t phase_hints; /* number of phases passed to SAT solver */
+    struct
+    {
+      uint32_t runs;
+      uint_least64_t nodes_before; /* summed over all runs */
+      uint_least64_t nodes_after;  /* summed over all runs */
+    } pp_passes[BTOR_PP_NUM_PASSES];
     BtorConstraintStats constraints;
     BtorConstraintStats oldconstraints;
     uint_least64_t expressions;
@@ -233,6 +256,10 @@ struct Btor
     double ucopt;
     double merge;
     double extract;
+    double flatstore;
+    double bvdomains;
+    double bvwidth;
+    double pp_passes[BTOR_PP_NUM_PASSES];
     double ack;
     double rewrite;
     double occurrence;
@@ -357,6 +384,9 @@ BtorNode *btor_substitute_nodes_node_map (Btor *btor,
 //            calling sat simplify etc.
 void btor_reset_incremental_usage (Btor *btor);
 void btor_add_again_assumptions (Btor *btor);
+void btor_set_phase_hint (Btor *btor, BtorNode *exp, const BtorBitVector *bv);
+void btor_add_phase_hints (Btor *btor);
+void btor_delete_phase_hints (Btor *btor);
 void btor_process_unsynthesized_constraints (Btor *btor);
 void btor_insert_unsynthesized_constraint (Btor *btor, BtorNode *constraint);
 void btor_set_simplified_exp (Btor *btor, BtorNode *exp, BtorNode *simplified);
@@ -9,13 +9,287 @@
 #include "btorlsutils.h"
 
 #include "btorbv.h"
+#include "btorclone.h"
+#include "btorcore.h"
 #include "btorlog.h"
 #include "btormodel.h"
 #include "btornode.h"
+#include "btoropt.h"
 #include "btorslsutils.h"
+#include "btorslvsls.h"
 #include "utils/btornodeiter.h"
+#include "utils/btornodemap.h"
 #include "utils/btorutil.h"
 
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+/*------------------------------------------------------------------------*/
+
+/* Maximum number of cone entries cached over all inputs. Cones of inputs
+ * moved after the limit has been reached are recomputed on each move. */
+#define BTOR_LSUTILS_MAX_CACHED_CONES (1u << 22)
+
+#define BTOR_LSUTILS_CONE_ROOT 1 /* constraint or assumption */
+#define BTOR_LSUTILS_CONE_CACHED 2
+
+/* previous assignment or score of a node changed by a tried move */
+struct BtorLsUndo
+{
+  int32_t id;
+  BtorHashTableData data; /* 0 if the node had no assignment */
+};
+
+typedef struct BtorLsUndo BtorLsUndo;
+
+BTOR_DECLARE_STACK (BtorLsUndo, BtorLsUndo);
+
+struct BtorLsCones
+{
+  Btor *btor;
+  /* dense index -> node, the bit-vector variables in the cone of the roots
+   * first, followed by their parent closure in ascending id order (i.e., in
+   * topological order) */
+  BtorNodePtrStack nodes;
+  uint32_t nvars;
+  /* node id - min_id -> dense index + 1, 0 if not in any cone */
+  uint32_t *id2idx;
+  int32_t min_id;
+  uint32_t size_id2idx;
+  uint8_t *flags;   /* dense index -> BTOR_LSUTILS_CONE_* */
+  uint32_t *mark;   /* dense index -> epoch of last visit */
+  uint32_t epoch;
+  BtorUIntStack *cones; /* dense index of variable -> sorted fan-out cone */
+  uint32_t ncached;
+  BtorUIntStack scratch;
+  BtorNodePtrStack visit;
+  BtorLsUndoStack undo_model;
+  BtorLsUndoStack undo_score;
+};
+
+static int32_t
+compare_uint_qsort_asc (const void *p, const void *q)
+{
+  uint32_t a = *(const uint32_t *) p, b = *(const uint32_t *) q;
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+static inline uint32_t
+get_idx (BtorLsCones *cones, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+  assert (exp->id >= cones->min_id);
+  assert ((uint32_t) (exp->id - cones->min_id) < cones->size_id2idx);
+  assert (cones->id2idx[exp->id - cones->min_id]);
+  return cones->id2idx[exp->id - cones->min_id] - 1;
+}
+
+BtorLsCones *
+btor_lsutils_new_cones (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, n;
+  int32_t max_id;
+  BtorNode *cur;
+  BtorNodeIterator nit;
+  BtorPtrHashTableIterator it;
+  BtorNodePtrStack stack;
+  BtorIntHashTable *cache;
+  BtorLsCones *res;
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  BTOR_CNEW (mm, res);
+  res->btor = btor;
+  BTOR_INIT_STACK (mm, res->nodes);
+  BTOR_INIT_STACK (mm, res->scratch);
+  BTOR_INIT_STACK (mm, res->visit);
+  BTOR_INIT_STACK (mm, res->undo_model);
+  BTOR_INIT_STACK (mm, res->undo_score);
+
+  /* collect variables reachable from the roots, only these are moved */
+  BTOR_INIT_STACK (mm, stack);
+  cache = btor_hashint_table_new (mm);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (stack, btor_iter_hashptr_next (&it));
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (stack));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    if (btor_node_is_bv_var (cur)) BTOR_PUSH_STACK (res->nodes, cur);
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (stack, cur->e[i]);
+  }
+  btor_hashint_table_delete (cache);
+  res->nvars = BTOR_COUNT_STACK (res->nodes);
+  qsort (res->nodes.start,
+         res->nvars,
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+
+  /* collect parent closure of these variables */
+  cache = btor_hashint_table_new (mm);
+  for (i = 0; i < res->nvars; i++)
+  {
+    cur = BTOR_PEEK_STACK (res->nodes, i);
+    btor_hashint_table_add (cache, cur->id);
+    btor_iter_parent_init (&nit, cur);
+    while (btor_iter_parent_has_next (&nit))
+      BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
+  }
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    assert (btor_node_is_regular (cur));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    BTOR_PUSH_STACK (res->nodes, cur);
+    btor_iter_parent_init (&nit, cur);
+    while (btor_iter_parent_has_next (&nit))
+      BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
+  }
+  BTOR_RELEASE_STACK (stack);
+  btor_hashint_table_delete (cache);
+  /* variables have no children and are never parents, hence putting them
+   * first preserves the topological order */
+  qsort (res->nodes.start + res->nvars,
+         BTOR_COUNT_STACK (res->nodes) - res->nvars,
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+
+  /* ids of the nodes in the cones are usually in a small range of all ids */
+  n           = BTOR_COUNT_STACK (res->nodes);
+  res->min_id = INT32_MAX;
+  max_id      = 0;
+  for (i = 0; i < n; i++)
+  {
+    cur = BTOR_PEEK_STACK (res->nodes, i);
+    if (cur->id < res->min_id) res->min_id = cur->id;
+    if (cur->id > max_id) max_id = cur->id;
+  }
+  /* no cones if all constraints have been eliminated */
+  if (!n) return res;
+  res->size_id2idx = (uint32_t) (max_id - res->min_id) + 1;
+  BTOR_CNEWN (mm, res->id2idx, res->size_id2idx);
+  BTOR_CNEWN (mm, res->flags, n);
+  BTOR_CNEWN (mm, res->mark, n);
+  BTOR_CNEWN (mm, res->cones, res->nvars);
+  for (i = 0; i < n; i++)
+  {
+    cur = BTOR_PEEK_STACK (res->nodes, i);
+    res->id2idx[cur->id - res->min_id] = i + 1;
+    if (cur->constraint || btor_hashptr_table_get (btor->assumptions, cur)
+        || btor_hashptr_table_get (btor->assumptions, btor_node_invert (cur)))
+      res->flags[i] |= BTOR_LSUTILS_CONE_ROOT;
+  }
+  return res;
+}
+
+void
+btor_lsutils_delete_cones (BtorLsCones *cones)
+{
+  assert (cones);
+
+  uint32_t i;
+  BtorMemMgr *mm;
+
+  mm = cones->btor->mm;
+  if (!BTOR_COUNT_STACK (cones->nodes)) goto DONE;
+  for (i = 0; i < cones->nvars; i++)
+    if (cones->flags[i] & BTOR_LSUTILS_CONE_CACHED)
+      BTOR_RELEASE_STACK (cones->cones[i]);
+  BTOR_DELETEN (mm, cones->cones, cones->nvars);
+  BTOR_DELETEN (mm, cones->mark, BTOR_COUNT_STACK (cones->nodes));
+  BTOR_DELETEN (mm, cones->flags, BTOR_COUNT_STACK (cones->nodes));
+  BTOR_DELETEN (mm, cones->id2idx, cones->size_id2idx);
+DONE:
+  BTOR_RELEASE_STACK (cones->nodes);
+  BTOR_RELEASE_STACK (cones->scratch);
+  BTOR_RELEASE_STACK (cones->visit);
+  assert (BTOR_EMPTY_STACK (cones->undo_model));
+  BTOR_RELEASE_STACK (cones->undo_model);
+  BTOR_RELEASE_STACK (cones->undo_score);
+  BTOR_DELETE (mm, cones);
+}
+
+/* Collect the dense indices of the fan-out cone of 'exps' (excluding 'exps')
+ * in topological order. The cone of a single input is cached. */
+static BtorUIntStack *
+get_cone (BtorLsCones *cones, BtorIntHashTable *exps)
+{
+  uint32_t idx, var;
+  BtorNode *cur;
+  BtorNodeIterator nit;
+  BtorIntHashTableIterator iit;
+  BtorUIntStack *res;
+
+  var = UINT32_MAX;
+  if (exps->count == 1)
+  {
+    btor_iter_hashint_init (&iit, exps);
+    var = get_idx (cones, btor_node_get_by_id (cones->btor,
+                                               btor_iter_hashint_next (&iit)));
+    assert (var < cones->nvars);
+    if (cones->flags[var] & BTOR_LSUTILS_CONE_CACHED)
+      return &cones->cones[var];
+  }
+
+  if (++cones->epoch == 0)
+  {
+    BTOR_CLRN (cones->mark, BTOR_COUNT_STACK (cones->nodes));
+    cones->epoch = 1;
+  }
+  BTOR_RESET_STACK (cones->scratch);
+  btor_iter_hashint_init (&iit, exps);
+  while (btor_iter_hashint_has_next (&iit))
+  {
+    cur = btor_node_get_by_id (cones->btor, btor_iter_hashint_next (&iit));
+    cones->mark[get_idx (cones, cur)] = cones->epoch;
+    btor_iter_parent_init (&nit, cur);
+    while (btor_iter_parent_has_next (&nit))
+      BTOR_PUSH_STACK (cones->visit, btor_iter_parent_next (&nit));
+  }
+  while (!BTOR_EMPTY_STACK (cones->visit))
+  {
+    cur = BTOR_POP_STACK (cones->visit);
+    idx = get_idx (cones, cur);
+    if (cones->mark[idx] == cones->epoch) continue;
+    cones->mark[idx] = cones->epoch;
+    BTOR_PUSH_STACK (cones->scratch, idx);
+    btor_iter_parent_init (&nit, cur);
+    while (btor_iter_parent_has_next (&nit))
+      BTOR_PUSH_STACK (cones->visit, btor_iter_parent_next (&nit));
+  }
+  qsort (cones->scratch.start,
+         BTOR_COUNT_STACK (cones->scratch),
+         sizeof (uint32_t),
+         compare_uint_qsort_asc);
+  res = &cones->scratch;
+
+  if (var != UINT32_MAX && !BTOR_EMPTY_STACK (cones->scratch)
+      && cones->ncached + BTOR_COUNT_STACK (cones->scratch)
+             <= BTOR_LSUTILS_MAX_CACHED_CONES)
+  {
+    res = &cones->cones[var];
+    BTOR_INIT_STACK (cones->btor->mm, *res);
+    BTOR_ENLARGE_STACK_TO_SIZE (*res, BTOR_COUNT_STACK (cones->scratch));
+    memcpy (res->start,
+            cones->scratch.start,
+            BTOR_COUNT_STACK (cones->scratch) * sizeof (uint32_t));
+    res->top = res->start + BTOR_COUNT_STACK (cones->scratch);
+    cones->ncached += BTOR_COUNT_STACK (cones->scratch);
+    cones->flags[var] |= BTOR_LSUTILS_CONE_CACHED;
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
 static void
 update_roots_table (Btor *btor,
                     BtorIntHashTable *roots,
@@ -65,6 +339,229 @@ update_roots_table (Btor *btor,
   }
 }
 
+/* Compute the assignment of 'exp' from the assignments of its children in
+ * 'bv_model'. */
+static BtorBitVector *
+compute_assignment (Btor *btor, BtorIntHashTable *bv_model, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t i;
+  bool free_e[3];
+  BtorNode *real;
+  BtorHashTableData *d;
+  BtorBitVector *res, *e[3];
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+
+  /* children are updated before their parents (topological order), use
+   * their assignments in place rather than copies */
+  for (i = 0; i < exp->arity; i++)
+  {
+    real      = btor_node_real_addr (exp->e[i]);
+    free_e[i] = false;
+    if (btor_node_is_bv_const (real))
+    {
+      e[i] = btor_node_is_inverted (exp->e[i])
+                 ? btor_node_bv_const_get_invbits (real)
+                 : btor_node_bv_const_get_bits (real);
+    }
+    else if (btor_node_is_inverted (exp->e[i])
+             && (d = btor_hashint_map_get (bv_model, -real->id)))
+    {
+      e[i] = d->as_ptr;
+    }
+    else
+    {
+      d = btor_hashint_map_get (bv_model, real->id);
+      /* Note: generate model enabled branch for ite (and does not
+       * generate model for nodes in the branch, hence !b may happen */
+      if (!d)
+        e[i] = btor_model_recursively_compute_assignment (
+            btor, bv_model, btor->fun_model, exp->e[i]);
+      else if (btor_node_is_inverted (exp->e[i]))
+        e[i] = btor_bv_not (mm, d->as_ptr);
+      else
+        e[i] = d->as_ptr;
+      free_e[i] = !d || btor_node_is_inverted (exp->e[i]);
+    }
+  }
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE: res = btor_bv_add (mm, e[0], e[1]); break;
+    case BTOR_BV_AND_NODE: res = btor_bv_and (mm, e[0], e[1]); break;
+    case BTOR_BV_EQ_NODE: res = btor_bv_eq (mm, e[0], e[1]); break;
+    case BTOR_BV_ULT_NODE: res = btor_bv_ult (mm, e[0], e[1]); break;
+    case BTOR_BV_SLL_NODE: res = btor_bv_sll (mm, e[0], e[1]); break;
+    case BTOR_BV_SRL_NODE: res = btor_bv_srl (mm, e[0], e[1]); break;
+    case BTOR_BV_MUL_NODE: res = btor_bv_mul (mm, e[0], e[1]); break;
+    case BTOR_BV_UDIV_NODE: res = btor_bv_udiv (mm, e[0], e[1]); break;
+    case BTOR_BV_UREM_NODE: res = btor_bv_urem (mm, e[0], e[1]); break;
+    case BTOR_BV_CONCAT_NODE: res = btor_bv_concat (mm, e[0], e[1]); break;
+    case BTOR_BV_SLICE_NODE:
+      res = btor_bv_slice (mm,
+                           e[0],
+                           btor_node_bv_slice_get_upper (exp),
+                           btor_node_bv_slice_get_lower (exp));
+      break;
+    default:
+      assert (btor_node_is_cond (exp));
+      res = btor_bv_is_true (e[0]) ? btor_bv_copy (mm, e[1])
+                                   : btor_bv_copy (mm, e[2]);
+  }
+  for (i = 0; i < exp->arity; i++)
+    if (free_e[i]) btor_bv_free (mm, e[i]);
+  return res;
+}
+
+static inline void
+record_undo (BtorLsUndoStack *undo, int32_t id, BtorHashTableData *d)
+{
+  BtorLsUndo u;
+  u.id = id;
+  if (d)
+    u.data = *d;
+  else
+    u.data.as_ptr = 0;
+  BTOR_PUSH_STACK (*undo, u);
+}
+
+/* Set the assignment of 'exp' in 'bv_model' to 'bv' (takes ownership).
+ * Previous assignments are recorded if 'record' is true, and freed
+ * otherwise. */
+static void
+set_assignment (Btor *btor,
+                BtorLsCones *cones,
+                bool record,
+                BtorIntHashTable *bv_model,
+                BtorNode *exp,
+                BtorBitVector *bv)
+{
+  assert (btor_node_is_regular (exp));
+
+  BtorHashTableData *d;
+
+  /* Note: generate model enabled branch for ite (and does not generate
+   *       model for nodes in the branch, hence !b may happen */
+  if (!(d = btor_hashint_map_get (bv_model, exp->id)))
+  {
+    if (record) record_undo (&cones->undo_model, exp->id, 0);
+    btor_node_copy (btor, exp);
+    btor_hashint_map_add (bv_model, exp->id)->as_ptr = bv;
+  }
+  else
+  {
+    if (record)
+      record_undo (&cones->undo_model, exp->id, d);
+    else
+      btor_bv_free (btor->mm, d->as_ptr);
+    d->as_ptr = bv;
+  }
+  if ((d = btor_hashint_map_get (bv_model, -exp->id)))
+  {
+    if (record)
+      record_undo (&cones->undo_model, -exp->id, d);
+    else
+      btor_bv_free (btor->mm, d->as_ptr);
+    d->as_ptr = btor_bv_not (btor->mm, bv);
+  }
+}
+
+/* Update the score of 'exp' and its negation, previous scores are recorded
+ * if 'record' is true. */
+static void
+compute_score (Btor *btor,
+               BtorLsCones *cones,
+               bool record,
+               BtorIntHashTable *bv_model,
+               BtorIntHashTable *score,
+               BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+  assert (btor_node_bv_get_width (btor, exp) == 1);
+
+  BtorHashTableData *d;
+
+  if (!(d = btor_hashint_map_get (score, exp->id)))
+  {
+    /* not reachable from the roots */
+    assert (!btor_hashint_map_contains (score, -exp->id));
+    return;
+  }
+  if (record) record_undo (&cones->undo_score, exp->id, d);
+  d->as_dbl = btor_slsutils_compute_score_node (
+      btor, bv_model, btor->fun_model, score, exp);
+  d = btor_hashint_map_get (score, -exp->id);
+  assert (d);
+  if (record) record_undo (&cones->undo_score, -exp->id, d);
+  d->as_dbl = btor_slsutils_compute_score_node (
+      btor, bv_model, btor->fun_model, score, btor_node_invert (exp));
+}
+
+/* Maximum increase of the score of the formula by root 'exp' (and/or its
+ * negation) w.r.t. the current scores. */
+static double
+max_score_gain (BtorLsScoreDelta *sd, BtorIntHashTable *score, BtorNode *exp)
+{
+  int32_t id;
+  uint32_t i;
+  double res;
+  BtorHashTableData *d;
+
+  res = 0.0;
+  for (i = 0, id = exp->id; i < 2; i++, id = -id)
+  {
+    if (!(d = btor_hashint_map_get (sd->weights, id))) continue;
+    res += (double) ((BtorSLSConstrData *) d->as_ptr)->weight
+           * (1.0 - btor_hashint_map_get (score, id)->as_dbl);
+  }
+  return res;
+}
+
+/* Update the score of root 'exp' (and/or its negation) and account for the
+ * difference to its previous score in the score of the formula. */
+static void
+compute_score_root (Btor *btor,
+                    BtorLsCones *cones,
+                    BtorIntHashTable *bv_model,
+                    BtorIntHashTable *score,
+                    BtorLsScoreDelta *sd,
+                    BtorNode *exp,
+                    double *gain,
+                    uint32_t *nunsat)
+{
+  int32_t id;
+  uint32_t i;
+  double weight[2], old_sc[2], new_sc;
+  BtorHashTableData *d;
+
+  for (i = 0, id = exp->id; i < 2; i++, id = -id)
+  {
+    weight[i] = 0.0;
+    if (!(d = btor_hashint_map_get (sd->weights, id))) continue;
+    weight[i] = (double) ((BtorSLSConstrData *) d->as_ptr)->weight;
+    old_sc[i] = btor_hashint_map_get (score, id)->as_dbl;
+  }
+  compute_score (btor, cones, true, bv_model, score, exp);
+  for (i = 0, id = exp->id; i < 2; i++, id = -id)
+  {
+    if (weight[i] == 0.0) continue;
+    new_sc = btor_hashint_map_get (score, id)->as_dbl;
+    sd->res += weight[i] * (new_sc - old_sc[i]);
+    *gain -= weight[i] * (1.0 - old_sc[i]);
+    if (old_sc[i] < 1.0) *nunsat -= 1;
+    if (new_sc < 1.0) *nunsat += 1;
+  }
+}
+
+static inline bool
+can_beat_bound (BtorLsScoreDelta *sd, double gain)
+{
+  return sd->res + gain > sd->bound
+         || (sd->ties && sd->res + gain == sd->bound);
+}
+
 /**
  * Update cone of influence.
  *
@@ -78,6 +575,11 @@ update_roots_table (Btor *btor,
  *           might become globally invalid, i.e., when a tried move
  *           is not actually performed, however in that particular case
  *           we do not update 'roots')
+ *
+ * If 'sd' is given, the move is only tried: assignments and scores are
+ * updated in one pass over the cone, which is aborted as soon as the score
+ * of the formula can not beat the bound anymore, and all changes are
+ * recorded to be reverted via 'btor_lsutils_undo_update_cone'.
  */
 void
 btor_lsutils_update_cone (Btor *btor,
@@ -85,7 +587,9 @@ btor_lsutils_update_cone (Btor *btor,
                           BtorIntHashTable *roots,
                           BtorIntHashTable *score,
                           BtorIntHashTable *exps,
+                          BtorLsCones *cones,
                           bool update_roots,
+                          BtorLsScoreDelta *sd,
                           uint64_t *stats_updates,
                           double *time_update_cone,
                           double *time_update_cone_reset,
@@ -99,22 +603,23 @@ btor_lsutils_update_cone (Btor *btor,
   assert (roots);
   assert (exps);
   assert (exps->count);
+  assert (cones);
+  assert (cones->btor == btor);
   assert (btor_opt_get (btor, BTOR_OPT_ENGINE) != BTOR_ENGINE_PROP
           || update_roots);
+  assert (!sd || (score && !update_roots));
+  assert (!sd || BTOR_EMPTY_STACK (cones->undo_model));
   assert (time_update_cone);
   assert (time_update_cone_reset);
   assert (time_update_cone_model_gen);
 
-  double start, delta;
-  uint32_t i, j;
-  int32_t id;
+  double start, delta, gain;
+  uint32_t i, idx, nunsat;
   BtorNode *exp, *cur;
-  BtorNodeIterator nit;
   BtorIntHashTableIterator iit;
   BtorHashTableData *d;
-  BtorNodePtrStack stack, cone;
-  BtorIntHashTable *cache;
-  BtorBitVector *bv, *e[3], *ass;
+  BtorUIntStack *cone;
+  BtorBitVector *bv, *ass;
   BtorMemMgr *mm;
 
   start = delta = btor_util_time_stamp ();
@@ -142,34 +647,34 @@ btor_lsutils_update_cone (Btor *btor,
 
   /* reset cone ----------------------------------------------------------- */
 
-  BTOR_INIT_STACK (mm, cone);
-  BTOR_INIT_STACK (mm, stack);
-  btor_iter_hashint_init (&iit, exps);
-  while (btor_iter_hashint_has_next (&iit))
-  {
-    exp = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
-    assert (btor_node_is_regular (exp));
-    assert (btor_node_is_bv_var (exp));
-    BTOR_PUSH_STACK (stack, exp);
-  }
-  cache = btor_hashint_table_new (mm);
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur = BTOR_POP_STACK (stack);
-    assert (btor_node_is_regular (cur));
-    if (btor_hashint_table_contains (cache, cur->id)) continue;
-    btor_hashint_table_add (cache, cur->id);
-    if (!btor_hashint_table_contains (exps, cur->id))
-      BTOR_PUSH_STACK (cone, cur);
-    *stats_updates += 1;
+  cone = get_cone (cones, exps);
 
-    /* push parents */
-    btor_iter_parent_init (&nit, cur);
-    while (btor_iter_parent_has_next (&nit))
-      BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
+  gain   = 0.0;
+  nunsat = 0;
+  if (sd)
+  {
+    sd->res    = sd->base;
+    sd->done   = false;
+    sd->pruned = false;
+    nunsat     = sd->nunsat;
+    if (sd->prune)
+    {
+      btor_iter_hashint_init (&iit, exps);
+      while (btor_iter_hashint_has_next (&iit))
+      {
+        exp = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
+        if (cones->flags[get_idx (cones, exp)] & BTOR_LSUTILS_CONE_ROOT)
+          gain += max_score_gain (sd, score, exp);
+      }
+      for (i = 0; i < BTOR_COUNT_STACK (*cone); i++)
+      {
+        idx = BTOR_PEEK_STACK (*cone, i);
+        if (cones->flags[idx] & BTOR_LSUTILS_CONE_ROOT)
+          gain +=
+              max_score_gain (sd, score, BTOR_PEEK_STACK (cones->nodes, idx));
+      }
+    }
   }
-  BTOR_RELEASE_STACK (stack);
-  btor_hashint_table_delete (cache);
 
   *time_update_cone_reset += btor_util_time_stamp () - delta;
 
@@ -180,179 +685,102 @@ btor_lsutils_update_cone (Btor *btor,
   {
     ass = (BtorBitVector *) exps->data[iit.cur_pos].as_ptr;
     exp = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
+    idx = get_idx (cones, exp);
 
     /* update model */
     d = btor_hashint_map_get (bv_model, exp->id);
     assert (d);
-    if (update_roots
-        && (exp->constraint || btor_hashptr_table_get (btor->assumptions, exp)
-            || btor_hashptr_table_get (btor->assumptions,
-                                       btor_node_invert (exp)))
+    if (update_roots && (cones->flags[idx] & BTOR_LSUTILS_CONE_ROOT)
         && btor_bv_compare (d->as_ptr, ass))
     {
       /* old assignment != new assignment */
       update_roots_table (btor, roots, exp, ass);
     }
-    btor_bv_free (mm, d->as_ptr);
-    d->as_ptr = btor_bv_copy (mm, ass);
-    if ((d = btor_hashint_map_get (bv_model, -exp->id)))
-    {
-      btor_bv_free (mm, d->as_ptr);
-      d->as_ptr = btor_bv_not (mm, ass);
-    }
+    set_assignment (
+        btor, cones, sd != 0, bv_model, exp, btor_bv_copy (mm, ass));
 
     /* update score */
     if (score && btor_node_bv_get_width (btor, exp) == 1)
     {
       assert (btor_hashint_map_contains (score, btor_node_get_id (exp)));
-      btor_hashint_map_get (score, btor_node_get_id (exp))->as_dbl =
-          btor_slsutils_compute_score_node (
-              btor, bv_model, btor->fun_model, score, exp);
-
-      assert (btor_hashint_map_contains (score, -btor_node_get_id (exp)));
-      btor_hashint_map_get (score, -btor_node_get_id (exp))->as_dbl =
-          btor_slsutils_compute_score_node (
-              btor, bv_model, btor->fun_model, score, btor_node_invert (exp));
+      if (sd && (cones->flags[idx] & BTOR_LSUTILS_CONE_ROOT))
+        compute_score_root (
+            btor, cones, bv_model, score, sd, exp, &gain, &nunsat);
+      else
+        compute_score (btor, cones, sd != 0, bv_model, score, exp);
     }
   }
 
-  qsort (cone.start,
-         BTOR_COUNT_STACK (cone),
-         sizeof (BtorNode *),
-         btor_node_compare_by_id_qsort_asc);
-
   /* update model of cone ------------------------------------------------- */
 
   delta = btor_util_time_stamp ();
 
-  for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+  for (i = 0; i < BTOR_COUNT_STACK (*cone); i++)
   {
-    cur = BTOR_PEEK_STACK (cone, i);
-    assert (btor_node_is_regular (cur));
-    for (j = 0; j < cur->arity; j++)
-    {
-      if (btor_node_is_bv_const (cur->e[j]))
-      {
-        e[j] =
-            btor_node_is_inverted (cur->e[j])
-                ? btor_bv_copy (mm, btor_node_bv_const_get_invbits (cur->e[j]))
-                : btor_bv_copy (mm, btor_node_bv_const_get_bits (cur->e[j]));
-      }
-      else
-      {
-        d = btor_hashint_map_get (bv_model,
-                                  btor_node_real_addr (cur->e[j])->id);
-        /* Note: generate model enabled branch for ite (and does not
-         * generate model for nodes in the branch, hence !b may happen */
-        if (!d)
-          e[j] = btor_model_recursively_compute_assignment (
-              btor, bv_model, btor->fun_model, cur->e[j]);
-        else
-          e[j] = btor_node_is_inverted (cur->e[j])
-                     ? btor_bv_not (mm, d->as_ptr)
-                     : btor_bv_copy (mm, d->as_ptr);
-      }
-    }
-    switch (cur->kind)
+    if (sd && sd->prune && !can_beat_bound (sd, gain))
     {
-      case BTOR_BV_ADD_NODE: bv = btor_bv_add (mm, e[0], e[1]); break;
-      case BTOR_BV_AND_NODE: bv = btor_bv_and (mm, e[0], e[1]); break;
-      case BTOR_BV_EQ_NODE: bv = btor_bv_eq (mm, e[0], e[1]); break;
-      case BTOR_BV_ULT_NODE: bv = btor_bv_ult (mm, e[0], e[1]); break;
-      case BTOR_BV_SLL_NODE: bv = btor_bv_sll (mm, e[0], e[1]); break;
-      case BTOR_BV_SRL_NODE: bv = btor_bv_srl (mm, e[0], e[1]); break;
-      case BTOR_BV_MUL_NODE: bv = btor_bv_mul (mm, e[0], e[1]); break;
-      case BTOR_BV_UDIV_NODE: bv = btor_bv_udiv (mm, e[0], e[1]); break;
-      case BTOR_BV_UREM_NODE: bv = btor_bv_urem (mm, e[0], e[1]); break;
-      case BTOR_BV_CONCAT_NODE: bv = btor_bv_concat (mm, e[0], e[1]); break;
-      case BTOR_BV_SLICE_NODE:
-        bv = btor_bv_slice (mm,
-                            e[0],
-                            btor_node_bv_slice_get_upper (cur),
-                            btor_node_bv_slice_get_lower (cur));
-        break;
-      default:
-        assert (btor_node_is_cond (cur));
-        bv = btor_bv_is_true (e[0]) ? btor_bv_copy (mm, e[1])
-                                    : btor_bv_copy (mm, e[2]);
+      sd->pruned = true;
+      break;
     }
 
-    /* update assignment */
+    idx = BTOR_PEEK_STACK (*cone, i);
+    cur = BTOR_PEEK_STACK (cones->nodes, idx);
+    assert (btor_node_is_regular (cur));
 
-    d = btor_hashint_map_get (bv_model, cur->id);
+    bv = compute_assignment (btor, bv_model, cur);
 
     /* update roots table */
-    if (update_roots
-        && (cur->constraint || btor_hashptr_table_get (btor->assumptions, cur)
-            || btor_hashptr_table_get (btor->assumptions,
-                                       btor_node_invert (cur))))
+    if (update_roots && (cones->flags[idx] & BTOR_LSUTILS_CONE_ROOT))
     {
+      d = btor_hashint_map_get (bv_model, cur->id);
       assert (d); /* must be contained, is root */
       /* old assignment != new assignment */
       if (btor_bv_compare (d->as_ptr, bv))
         update_roots_table (btor, roots, cur, bv);
     }
 
-    /* update assignments */
-    /* Note: generate model enabled branch for ite (and does not generate
-     *       model for nodes in the branch, hence !b may happen */
-    if (!d)
-    {
-      btor_node_copy (btor, cur);
-      btor_hashint_map_add (bv_model, cur->id)->as_ptr = bv;
-    }
-    else
-    {
-      btor_bv_free (mm, d->as_ptr);
-      d->as_ptr = bv;
-    }
+    set_assignment (btor, cones, sd != 0, bv_model, cur, bv);
 
-    if ((d = btor_hashint_map_get (bv_model, -cur->id)))
+    /* scores only depend on the assignments and scores of the children */
+    if (sd && btor_node_bv_get_width (btor, cur) == 1)
     {
-      btor_bv_free (mm, d->as_ptr);
-      d->as_ptr = btor_bv_not (mm, bv);
+      if (cones->flags[idx] & BTOR_LSUTILS_CONE_ROOT)
+        compute_score_root (
+            btor, cones, bv_model, score, sd, cur, &gain, &nunsat);
+      else
+        compute_score (btor, cones, true, bv_model, score, cur);
     }
-    /* cleanup */
-    for (j = 0; j < cur->arity; j++) btor_bv_free (mm, e[j]);
   }
+  *stats_updates += exps->count + i;
   *time_update_cone_model_gen += btor_util_time_stamp () - delta;
 
+  if (sd)
+  {
+    if (sd->pruned)
+      sd->res += gain;
+    else
+      sd->done = nunsat == 0;
+  }
+
   /* update score of cone ------------------------------------------------- */
 
-  if (score)
+  if (score && !sd)
   {
     delta = btor_util_time_stamp ();
-    for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+    for (i = 0; i < BTOR_COUNT_STACK (*cone); i++)
     {
-      cur = BTOR_PEEK_STACK (cone, i);
+      cur = BTOR_PEEK_STACK (cones->nodes, BTOR_PEEK_STACK (*cone, i));
       assert (btor_node_is_regular (cur));
-
       if (btor_node_bv_get_width (btor, cur) != 1) continue;
-
-      id = btor_node_get_id (cur);
-      if (!btor_hashint_map_contains (score, id))
-      {
-        /* not reachable from the roots */
-        assert (!btor_hashint_map_contains (score, -id));
-        continue;
-      }
-      btor_hashint_map_get (score, id)->as_dbl =
-          btor_slsutils_compute_score_node (
-              btor, bv_model, btor->fun_model, score, cur);
-      assert (btor_hashint_map_contains (score, -id));
-      btor_hashint_map_get (score, -id)->as_dbl =
-          btor_slsutils_compute_score_node (
-              btor, bv_model, btor->fun_model, score, btor_node_invert (cur));
+      compute_score (btor, cones, false, bv_model, score, cur);
     }
     *time_update_cone_compute_score += btor_util_time_stamp () - delta;
   }
 
-  BTOR_RELEASE_STACK (cone);
-
 #ifndef NDEBUG
   btor_iter_hashptr_init (&pit, btor->unsynthesized_constraints);
   btor_iter_hashptr_queue (&pit, btor->assumptions);
-  while (btor_iter_hashptr_has_next (&pit))
+  while (!sd && btor_iter_hashptr_has_next (&pit))
   {
     root = btor_iter_hashptr_next (&pit);
     if (btor_bv_is_false (btor_model_get_bv (btor, root)))
@@ -363,3 +791,492 @@ btor_lsutils_update_cone (Btor *btor,
 #endif
   *time_update_cone += btor_util_time_stamp () - start;
 }
+
+void
+btor_lsutils_undo_update_cone (Btor *btor,
+                               BtorIntHashTable *bv_model,
+                               BtorIntHashTable *score,
+                               BtorLsCones *cones)
+{
+  assert (btor);
+  assert (bv_model);
+  assert (score);
+  assert (cones);
+
+  BtorLsUndo u;
+  BtorHashTableData *d;
+
+  /* restore in reverse order, the first recorded value is the original */
+  while (!BTOR_EMPTY_STACK (cones->undo_model))
+  {
+    u = BTOR_POP_STACK (cones->undo_model);
+    d = btor_hashint_map_get (bv_model, u.id);
+    assert (d);
+    btor_bv_free (btor->mm, d->as_ptr);
+    if (u.data.as_ptr)
+    {
+      d->as_ptr = u.data.as_ptr;
+    }
+    else
+    {
+      btor_hashint_map_remove (bv_model, u.id, 0);
+      btor_node_release (btor, btor_node_get_by_id (btor, u.id));
+    }
+  }
+  while (!BTOR_EMPTY_STACK (cones->undo_score))
+  {
+    u = BTOR_POP_STACK (cones->undo_score);
+    btor_hashint_map_get (score, u.id)->as_dbl = u.data.as_dbl;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Adaptive strategy controller (see btorlsutils.h). */
+
+/* stagnation: no improvement within nroots / THETA moves (at least MIN) */
+#define BTOR_LSUTILS_ADAPT_THETA 6
+#define BTOR_LSUTILS_ADAPT_MIN_STAGNATION 100
+#define BTOR_LSUTILS_ADAPT_PHI 0.2
+/* initial number of moves without improvement that trigger a restart */
+#define BTOR_LSUTILS_ADAPT_RESTART_BASE 100
+#define BTOR_LSUTILS_ADAPT_MAX_TRACE 1000
+
+#define BTOR_LSUTILS_ADAPT_NOISE_INC '+'
+#define BTOR_LSUTILS_ADAPT_NOISE_DEC '-'
+#define BTOR_LSUTILS_ADAPT_RESTART 'r'
+
+struct BtorLsTraceEntry
+{
+  char event;
+  uint32_t moves;
+  uint32_t nunsat;
+  uint32_t best;
+  double noise;
+  double success; /* ratio of improving moves since previous entry */
+};
+
+typedef struct BtorLsTraceEntry BtorLsTraceEntry;
+
+BTOR_DECLARE_STACK (BtorLsTraceEntry, BtorLsTraceEntry);
+
+struct BtorLsController
+{
+  Btor *btor;
+  BtorOption *opts;
+  uint32_t *base; /* configured values of 'opts' */
+  uint32_t nopts;
+  bool restarts;
+  uint32_t stagnation;
+  double noise;
+
+  uint32_t moves;
+  uint32_t nunsat;
+  /* number of unsatisfied roots and moves at the last noise adjustment */
+  uint32_t last_nunsat;
+  uint32_t last_adjust;
+  /* best number of unsatisfied roots of current run and over all runs */
+  uint32_t run_best;
+  uint32_t run_best_moves;
+  uint32_t best;
+  uint32_t restart_limit;
+
+  /* moves and improving moves since the last trace entry */
+  uint32_t window_moves;
+  uint32_t window_improved;
+  BtorLsTraceEntryStack trace;
+  uint32_t ntrace_dropped;
+
+  uint32_t *stats_noise_inc;
+  uint32_t *stats_noise_dec;
+};
+
+static void
+controller_set_probs (BtorLsController *ctrl)
+{
+  uint32_t i;
+  int32_t p;
+
+  for (i = 0; i < ctrl->nopts; i++)
+  {
+    p = ctrl->base[i];
+    p += (int32_t) (ctrl->noise * ((int32_t) BTOR_PROB_MAX / 2 - p));
+    btor_opt_set (ctrl->btor, ctrl->opts[i], (uint32_t) p);
+  }
+}
+
+static void
+controller_trace (BtorLsController *ctrl, char event)
+{
+  BtorLsTraceEntry e;
+
+  if (BTOR_COUNT_STACK (ctrl->trace) >= BTOR_LSUTILS_ADAPT_MAX_TRACE)
+  {
+    ctrl->ntrace_dropped += 1;
+  }
+  else
+  {
+    e.event   = event;
+    e.moves   = ctrl->moves;
+    e.nunsat  = ctrl->nunsat;
+    e.best    = ctrl->run_best;
+    e.noise   = ctrl->noise;
+    e.success = ctrl->window_moves ? (double) ctrl->window_improved
+                                         / ctrl->window_moves
+                                   : 0;
+    BTOR_PUSH_STACK (ctrl->trace, e);
+  }
+  ctrl->window_moves    = 0;
+  ctrl->window_improved = 0;
+}
+
+BtorLsController *
+btor_lsutils_new_controller (Btor *btor,
+                             const BtorOption *opts,
+                             uint32_t nopts,
+                             uint32_t nroots,
+                             bool restarts,
+                             uint32_t *stats_noise_inc,
+                             uint32_t *stats_noise_dec)
+{
+  assert (btor);
+  assert (!nopts || opts);
+  assert (!nopts || stats_noise_inc);
+  assert (!nopts || stats_noise_dec);
+
+  uint32_t i;
+  BtorLsController *res;
+
+  BTOR_CNEW (btor->mm, res);
+  res->btor  = btor;
+  res->nopts = nopts;
+  if (nopts)
+  {
+    BTOR_NEWN (btor->mm, res->opts, nopts);
+    BTOR_NEWN (btor->mm, res->base, nopts);
+    for (i = 0; i < nopts; i++)
+    {
+      res->opts[i] = opts[i];
+      res->base[i] = btor_opt_get (btor, opts[i]);
+    }
+  }
+  res->restarts   = restarts;
+  res->stagnation = nroots / BTOR_LSUTILS_ADAPT_THETA;
+  if (res->stagnation < BTOR_LSUTILS_ADAPT_MIN_STAGNATION)
+    res->stagnation = BTOR_LSUTILS_ADAPT_MIN_STAGNATION;
+  res->best            = UINT32_MAX;
+  res->restart_limit   = BTOR_LSUTILS_ADAPT_RESTART_BASE;
+  res->stats_noise_inc = stats_noise_inc;
+  res->stats_noise_dec = stats_noise_dec;
+  BTOR_INIT_STACK (btor->mm, res->trace);
+  return res;
+}
+
+void
+btor_lsutils_delete_controller (BtorLsController *ctrl)
+{
+  assert (ctrl);
+
+  uint32_t i;
+  BtorMemMgr *mm;
+
+  mm = ctrl->btor->mm;
+  for (i = 0; i < ctrl->nopts; i++)
+    btor_opt_set (ctrl->btor, ctrl->opts[i], ctrl->base[i]);
+  if (ctrl->nopts)
+  {
+    BTOR_DELETEN (mm, ctrl->opts, ctrl->nopts);
+    BTOR_DELETEN (mm, ctrl->base, ctrl->nopts);
+  }
+  BTOR_RELEASE_STACK (ctrl->trace);
+  BTOR_DELETE (mm, ctrl);
+}
+
+void
+btor_lsutils_controller_start (BtorLsController *ctrl, uint32_t nunsat)
+{
+  assert (ctrl);
+
+  ctrl->nunsat         = nunsat;
+  ctrl->last_nunsat    = nunsat;
+  ctrl->last_adjust    = ctrl->moves;
+  ctrl->run_best       = nunsat;
+  ctrl->run_best_moves = ctrl->moves;
+}
+
+bool
+btor_lsutils_controller_move (BtorLsController *ctrl, uint32_t nunsat)
+{
+  assert (ctrl);
+
+  ctrl->moves += 1;
+  ctrl->window_moves += 1;
+  if (nunsat < ctrl->nunsat) ctrl->window_improved += 1;
+  ctrl->nunsat = nunsat;
+
+  if (nunsat < ctrl->run_best)
+  {
+    ctrl->run_best       = nunsat;
+    ctrl->run_best_moves = ctrl->moves;
+  }
+
+  /* adapt noise */
+  if (ctrl->nopts && nunsat < ctrl->last_nunsat)
+  {
+    ctrl->noise -= ctrl->noise * BTOR_LSUTILS_ADAPT_PHI / 2;
+    ctrl->last_nunsat = nunsat;
+    ctrl->last_adjust = ctrl->moves;
+    *ctrl->stats_noise_dec += 1;
+    controller_set_probs (ctrl);
+    controller_trace (ctrl, BTOR_LSUTILS_ADAPT_NOISE_DEC);
+  }
+  else if (ctrl->nopts && ctrl->moves - ctrl->last_adjust > ctrl->stagnation)
+  {
+    ctrl->noise += (1 - ctrl->noise) * BTOR_LSUTILS_ADAPT_PHI;
+    ctrl->last_nunsat = nunsat;
+    ctrl->last_adjust = ctrl->moves;
+    *ctrl->stats_noise_inc += 1;
+    controller_set_probs (ctrl);
+    controller_trace (ctrl, BTOR_LSUTILS_ADAPT_NOISE_INC);
+  }
+
+  /* adapt restart interval */
+  if (ctrl->restarts
+      && ctrl->moves - ctrl->run_best_moves >= ctrl->restart_limit)
+  {
+    if (ctrl->run_best < ctrl->best)
+    {
+      ctrl->best = ctrl->run_best;
+      if (ctrl->restart_limit > BTOR_LSUTILS_ADAPT_RESTART_BASE)
+        ctrl->restart_limit /= 2;
+    }
+    else if (ctrl->restart_limit <= UINT32_MAX / 2)
+    {
+      ctrl->restart_limit *= 2;
+    }
+    controller_trace (ctrl, BTOR_LSUTILS_ADAPT_RESTART);
+    return true;
+  }
+  return false;
+}
+
+void
+btor_lsutils_print_controller_trace (BtorLsController *ctrl)
+{
+  assert (ctrl);
+
+  size_t i;
+  Btor *btor;
+  BtorLsTraceEntry *e;
+
+  btor = ctrl->btor;
+  if (btor_opt_get (btor, BTOR_OPT_VERBOSITY) < 2) return;
+
+  BTOR_MSG (btor->msg, 2, "");
+  BTOR_MSG (btor->msg,
+            2,
+            "adaptive controller trace (%c noise inc, %c noise dec, "
+            "%c restart):",
+            BTOR_LSUTILS_ADAPT_NOISE_INC,
+            BTOR_LSUTILS_ADAPT_NOISE_DEC,
+            BTOR_LSUTILS_ADAPT_RESTART);
+  for (i = 0; i < BTOR_COUNT_STACK (ctrl->trace); i++)
+  {
+    e = ctrl->trace.start + i;
+    BTOR_MSG (btor->msg,
+              2,
+              "%c %10u moves, %6u unsat, %6u best, "
+              "noise %.3f, improving moves %.3f",
+              e->event,
+              e->moves,
+              e->nunsat,
+              e->best,
+              e->noise,
+              e->success);
+  }
+  if (ctrl->ntrace_dropped)
+    BTOR_MSG (btor->msg, 2, "%u more entries omitted", ctrl->ntrace_dropped);
+  BTOR_MSG (btor->msg,
+            2,
+            "final noise %.3f, restart interval %u moves",
+            ctrl->noise,
+            ctrl->restart_limit);
+}
+
+/*------------------------------------------------------------------------*/
+
+#ifdef BTOR_HAVE_PTHREADS
+
+struct BtorLsPortfolio
+{
+  Btor *btor;
+  bool found_result;
+  pthread_mutex_t found_result_mutex;
+};
+
+typedef struct BtorLsPortfolio BtorLsPortfolio;
+
+struct BtorLsWorker
+{
+  Btor *clone;
+  BtorNodeMap *exp_map;
+  BtorSolverResult result;
+  BtorLsPortfolio *portfolio;
+};
+
+typedef struct BtorLsWorker BtorLsWorker;
+
+static int32_t
+portfolio_terminate (void *state)
+{
+  BtorLsPortfolio *portfolio = state;
+  Btor *btor                 = portfolio->btor;
+
+  if (portfolio->found_result) return 1;
+  /* Note: the termination callback of the user is called from all workers */
+  return btor->cbs.term.fun
+         && ((int32_t (*) (void *)) btor->cbs.term.fun) (btor->cbs.term.state);
+}
+
+static void *
+portfolio_work (void *state)
+{
+  BtorLsWorker *worker;
+  BtorSolverResult res;
+
+  worker = state;
+  res    = worker->clone->slv->api.sat (worker->clone->slv);
+  pthread_mutex_lock (&worker->portfolio->found_result_mutex);
+  if (res != BTOR_RESULT_UNKNOWN) worker->portfolio->found_result = true;
+  pthread_mutex_unlock (&worker->portfolio->found_result_mutex);
+  worker->result = res;
+  return NULL;
+}
+
+static uint32_t
+count_false_roots (Btor *btor)
+{
+  uint32_t res;
+  BtorNode *root;
+  BtorPtrHashTableIterator it;
+
+  res = 0;
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    root = btor_iter_hashptr_next (&it);
+    if (btor_bv_is_zero (btor_model_get_bv (btor, root))) res += 1;
+  }
+  return res;
+}
+
+/* Install the assignment of the inputs in the model of 'worker' as model of
+ * 'btor'. */
+static void
+install_worker_model (Btor *btor, BtorLsWorker *worker)
+{
+  BtorNode *var, *cvar;
+  BtorPtrHashTableIterator it;
+
+  btor_model_init_bv (btor, &btor->bv_model);
+  btor_model_init_fun (btor, &btor->fun_model);
+  btor_iter_hashptr_init (&it, btor->bv_vars);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    var = btor_node_get_simplified (btor, btor_iter_hashptr_next (&it));
+    if (!btor_node_is_regular (var) || !btor_node_is_bv_var (var)
+        || btor_hashint_map_contains (btor->bv_model, var->id))
+      continue;
+    cvar = btor_nodemap_mapped (worker->exp_map, var);
+    if (!cvar) continue;
+    btor_model_add_to_bv (
+        btor, btor->bv_model, var, btor_model_get_bv (worker->clone, cvar));
+  }
+  btor_model_generate (btor, btor->bv_model, btor->fun_model, false);
+}
+
+BtorSolverResult
+btor_lsutils_sat_portfolio (Btor *btor,
+                            BtorSolver *slv,
+                            uint32_t nthreads,
+                            BtorSolver *(*new_solver) (Btor *),
+                            void (*add_stats) (BtorSolver *, BtorSolver *))
+{
+  assert (btor);
+  assert (slv);
+  assert (nthreads > 1);
+  assert (new_solver);
+  assert (add_stats);
+
+  uint32_t i, seed, nroots, min_nroots;
+  BtorSolverResult res;
+  BtorLsPortfolio portfolio;
+  BtorLsWorker *workers, *best;
+  pthread_t *threads;
+  Btor *clone;
+
+  portfolio.btor         = btor;
+  portfolio.found_result = false;
+  pthread_mutex_init (&portfolio.found_result_mutex, 0);
+
+  seed = btor_opt_get (btor, BTOR_OPT_SEED);
+  BTOR_CNEWN (btor->mm, workers, nthreads);
+  BTOR_CNEWN (btor->mm, threads, nthreads);
+  for (i = 0; i < nthreads; i++)
+  {
+    /* Note: cloning is not thread-safe, clone all before starting */
+    clone = btor_clone_exp_layer (btor, &workers[i].exp_map, false);
+    btor_opt_set (clone, BTOR_OPT_LS_NTHREADS, 1);
+    btor_opt_set (clone, BTOR_OPT_VERBOSITY, 0);
+    btor_opt_set (clone, BTOR_OPT_LOGLEVEL, 0);
+    /* worker 0 continues with the current state of the random number
+     * generator, i.e., behaves like the sequential engine */
+    if (i > 0) btor_opt_set (clone, BTOR_OPT_SEED, seed + i);
+    btor_set_term (clone, portfolio_terminate, &portfolio);
+    /* fresh solver, the statistics of the cloned one are those of 'slv' */
+    if (clone->slv) clone->slv->api.delet (clone->slv);
+    clone->slv           = new_solver (clone);
+    workers[i].clone     = clone;
+    workers[i].portfolio = &portfolio;
+  }
+  BTOR_MSG (btor->msg, 1, "started %u local search workers", nthreads);
+
+  for (i = 0; i < nthreads; i++)
+    pthread_create (&threads[i], 0, portfolio_work, &workers[i]);
+  for (i = 0; i < nthreads; i++) pthread_join (threads[i], 0);
+
+  res        = BTOR_RESULT_UNKNOWN;
+  best       = 0;
+  min_nroots = UINT32_MAX;
+  for (i = 0; i < nthreads; i++)
+  {
+    add_stats (slv, workers[i].clone->slv);
+    if (res != BTOR_RESULT_UNKNOWN) continue;
+    if (workers[i].result != BTOR_RESULT_UNKNOWN)
+    {
+      BTOR_MSG (btor->msg, 1, "local search worker %u determined result", i);
+      res  = workers[i].result;
+      best = &workers[i];
+    }
+    else if (workers[i].clone->bv_model
+             && (nroots = count_false_roots (workers[i].clone)) < min_nroots)
+    {
+      min_nroots = nroots;
+      best       = &workers[i];
+    }
+  }
+  if (best && res != BTOR_RESULT_UNSAT) install_worker_model (btor, best);
+
+  for (i = 0; i < nthreads; i++)
+  {
+    btor_nodemap_delete (workers[i].exp_map);
+    btor_delete (workers[i].clone);
+  }
+  BTOR_DELETEN (btor->mm, threads, nthreads);
+  BTOR_DELETEN (btor->mm, workers, nthreads);
+  pthread_mutex_destroy (&portfolio.found_result_mutex);
+  return res;
+}
+#endif
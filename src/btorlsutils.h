@@ -9,9 +9,42 @@
 #ifndef BTORLSUTILS_H_INCLUDED
 #define BTORLSUTILS_H_INCLUDED
 
+#include "btorslv.h"
 #include "btortypes.h"
 #include "utils/btorhashint.h"
 
+/**
+ * Dense, topologically ordered representation of the fan-out cones of all
+ * bit-vector variables, computed once per local search sat call.
+ */
+typedef struct BtorLsCones BtorLsCones;
+
+BtorLsCones* btor_lsutils_new_cones (Btor* btor);
+
+void btor_lsutils_delete_cones (BtorLsCones* cones);
+
+/**
+ * Incremental score of the formula under a move tried by the SLS engine.
+ * Only the roots in the cone of the moved inputs are rescored, the score of
+ * the formula is derived from the score 'base' of the current assignment.
+ */
+struct BtorLsScoreDelta
+{
+  BtorIntHashTable* weights; /* root -> BtorSLSConstrData */
+  double base;               /* score of the formula before the move */
+  uint32_t nunsat;           /* number of unsatisfied roots before the move */
+  /* stop as soon as the score can not be greater than (or equal to, if
+   * 'ties') 'bound' */
+  bool prune;
+  bool ties;
+  double bound;
+  /* result */
+  double res; /* score of the formula, an upper bound if 'pruned' */
+  bool done;  /* all roots satisfied */
+  bool pruned;
+};
+typedef struct BtorLsScoreDelta BtorLsScoreDelta;
+
 /**
  * Update cone of incluence as a consequence of a local search move.
  *
@@ -19,17 +52,89 @@
  *         + PROP engine: always
  *         + SLS  engine: only if an actual move is performed
  *                        (not during neighborhood exploration, 'try_move')
+ *
+ * If 'sd' is given (SLS engine, 'try_move' only), the move is only tried:
+ * the score of the formula is computed incrementally (see BtorLsScoreDelta)
+ * and all changes to 'bv_model' and 'score' must be reverted via
+ * 'btor_lsutils_undo_update_cone' before the next update.
  */
 void btor_lsutils_update_cone (Btor* btor,
                                BtorIntHashTable* bv_model,
                                BtorIntHashTable* roots,
                                BtorIntHashTable* score,
                                BtorIntHashTable* exps,
+                               BtorLsCones* cones,
                                bool update_roots,
+                               BtorLsScoreDelta* sd,
                                uint64_t* stats_updates,
                                double* time_update_cone,
                                double* time_update_cone_reset,
                                double* time_update_cone_model_gen,
                                double* time_update_cone_compute_score);
 
+/** Revert the changes of the last move tried via btor_lsutils_update_cone. */
+void btor_lsutils_undo_update_cone (Btor* btor,
+                                    BtorIntHashTable* bv_model,
+                                    BtorIntHashTable* score,
+                                    BtorLsCones* cones);
+
+/**
+ * Adaptive strategy controller for the local search engines (option
+ * BTOR_OPT_LS_ADAPTIVE).
+ *
+ * Monitors the number of unsatisfied roots after each move and adapts the
+ * noise of the search online, similar to the adaptive noise mechanism of
+ * Adaptive Novelty+: the noise is increased if the number of unsatisfied
+ * roots did not improve within a number of moves proportional to the number
+ * of roots, and decreased on improvement. With noise n, each of the given
+ * probability options is set to p + n * (BTOR_PROB_MAX / 2 - p), where p is
+ * its configured value (restored on deletion). If no options are given,
+ * only restarts are adapted and the statistics counters may be 0.
+ *
+ * If 'restarts' is true, the controller further replaces the fixed restart
+ * schedule: a restart is requested if the best number of unsatisfied roots
+ * of the current run did not improve for a given number of moves, which is
+ * doubled whenever a run does not improve on the best run so far.
+ */
+typedef struct BtorLsController BtorLsController;
+
+BtorLsController* btor_lsutils_new_controller (Btor* btor,
+                                               const BtorOption* opts,
+                                               uint32_t nopts,
+                                               uint32_t nroots,
+                                               bool restarts,
+                                               uint32_t* stats_noise_inc,
+                                               uint32_t* stats_noise_dec);
+
+void btor_lsutils_delete_controller (BtorLsController* ctrl);
+
+/** Start a (re)run with 'nunsat' unsatisfied roots. */
+void btor_lsutils_controller_start (BtorLsController* ctrl, uint32_t nunsat);
+
+/**
+ * Record a move that resulted in 'nunsat' unsatisfied roots.
+ * Returns true if the engine should restart.
+ */
+bool btor_lsutils_controller_move (BtorLsController* ctrl, uint32_t nunsat);
+
+/** Print the adaptation trace (verbosity level 2). */
+void btor_lsutils_print_controller_trace (BtorLsController* ctrl);
+
+#ifdef BTOR_HAVE_PTHREADS
+/**
+ * Run 'nthreads' workers of the local search engine created via 'new_solver'
+ * in parallel, each on a clone of the expression layer with a different seed.
+ * The first worker that determines a result terminates all others. The model
+ * of the winning worker (or the worker with the least number of unsatisfied
+ * roots if none) is installed as model of 'btor', and the statistics of all
+ * workers are added to 'slv' via 'add_stats'.
+ */
+BtorSolverResult btor_lsutils_sat_portfolio (
+    Btor* btor,
+    BtorSolver* slv,
+    uint32_t nthreads,
+    BtorSolver* (*new_solver) (Btor*),
+    void (*add_stats) (BtorSolver*, BtorSolver*));
+#endif
+
 #endif
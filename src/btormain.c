@@ -78,6 +78,9 @@ enum BtorMainOption
   BTORMAIN_OPT_DUMP_AAG,
   BTORMAIN_OPT_DUMP_AIG,
   BTORMAIN_OPT_DUMP_AIGER_MERGE,
+  BTORMAIN_OPT_DUMP_LEMMAS,
+  BTORMAIN_OPT_LOAD_LEMMAS,
+  BTORMAIN_OPT_PP_PIPELINE,
   /* this MUST be the last entry! */
   BTORMAIN_OPT_NUM_OPTS,
 };
@@ -113,6 +116,8 @@ struct BtorMainApp
   FILE *outfile;
   char *outfile_name;
   bool close_outfile;
+  char *lemmas_outfile_name;
+  char *lemmas_infile_name;
 };
 
 /*------------------------------------------------------------------------*/
@@ -383,6 +388,42 @@ btormain_init_opts (BtorMainApp *app)
                      true,
                      BTOR_ARG_EXPECT_NONE,
                      "merge all roots of AIG [0]");
+  btormain_init_opt (app,
+                     BTORMAIN_OPT_DUMP_LEMMAS,
+                     true,
+                     false,
+                     "dump-lemmas",
+                     0,
+                     0,
+                     0,
+                     0,
+                     false,
+                     BTOR_ARG_EXPECT_STR,
+                     "dump lemmas in SMT-LIB v2 format to file");
+  btormain_init_opt (app,
+                     BTORMAIN_OPT_LOAD_LEMMAS,
+                     true,
+                     false,
+                     "load-lemmas",
+                     0,
+                     0,
+                     0,
+                     0,
+                     false,
+                     BTOR_ARG_EXPECT_STR,
+                     "load lemmas dumped via --dump-lemmas from file");
+  btormain_init_opt (app,
+                     BTORMAIN_OPT_PP_PIPELINE,
+                     true,
+                     false,
+                     "pp-pipeline",
+                     0,
+                     0,
+                     0,
+                     0,
+                     false,
+                     BTOR_ARG_EXPECT_STR,
+                     "comma separated list of preprocessing passes");
 }
 
 static bool
@@ -609,8 +650,11 @@ print_opt (BtorMainApp *app,
 
   if (!strcmp (lng, "time"))
     sprintf (paramstr, "<seconds>");
-  else if (!strcmp (lng, "output"))
+  else if (!strcmp (lng, "output") || !strcmp (lng, "dump-lemmas")
+           || !strcmp (lng, "load-lemmas"))
     sprintf (paramstr, "<file>");
+  else if (!strcmp (lng, "pp-pipeline"))
+    sprintf (paramstr, "<passes>");
   else if (!strcmp (lng, boolector_get_opt_lng (app->btor, BTOR_OPT_ENGINE))
            || !strcmp (lng,
                        boolector_get_opt_lng (app->btor, BTOR_OPT_SAT_ENGINE)))
@@ -789,7 +833,8 @@ print_help (BtorMainApp *app)
     if (!app->options[mo].general) continue;
     if (mo == BTORMAIN_OPT_TIME || mo == BTORMAIN_OPT_HEX
         || mo == BTORMAIN_OPT_BTOR || mo == BTORMAIN_OPT_BTOR2
-        || mo == BTORMAIN_OPT_DUMP_BTOR)
+        || mo == BTORMAIN_OPT_DUMP_BTOR || mo == BTORMAIN_OPT_DUMP_LEMMAS
+        || mo == BTORMAIN_OPT_PP_PIPELINE)
       fprintf (out, "\n");
     PRINT_MAIN_OPT (app, &app->options[mo]);
   }
@@ -902,6 +947,27 @@ print_sat_result (BtorMainApp *app, int32_t sat_result)
   }
 }
 
+static bool
+dump_lemmas (BtorMainApp *app)
+{
+  assert (app);
+  assert (app->lemmas_outfile_name);
+
+  FILE *file;
+
+  file = fopen (app->lemmas_outfile_name, "w");
+  if (!file)
+  {
+    btormain_error (app, "can not create '%s'", app->lemmas_outfile_name);
+    return false;
+  }
+  if (g_verbosity)
+    btormain_msg ("dumping lemmas to '%s'", app->lemmas_outfile_name);
+  boolector_dump_lemmas_smt2 (app->btor, file);
+  fclose (file);
+  return true;
+}
+
 /*------------------------------------------------------------------------*/
 
 #ifdef BTOR_HAVE_SIGNALS
@@ -994,6 +1060,7 @@ boolector_main (int32_t argc, char **argv)
   uint32_t val;
   bool dump_merge;
   char *cmd, *parse_err_msg;
+  FILE *lemmas_file;
   BtorParsedOpt *po;
   BtorParsedOptPtrStack opts;
   BtorParsedInput *pin;
@@ -1197,6 +1264,18 @@ boolector_main (int32_t argc, char **argv)
           boolector_set_opt (btor, BTOR_OPT_OUTPUT_FORMAT, dump);
           boolector_set_opt (btor, BTOR_OPT_PARSE_INTERACTIVE, 0);
           break;
+
+        case BTORMAIN_OPT_PP_PIPELINE:
+          if (!btor_pp_parse_pipeline (mm, po->valstr, 0))
+          {
+            btormain_error (g_app,
+                            "invalid argument '%s' for '%s'",
+                            po->valstr,
+                            po->orig.start);
+            goto DONE;
+          }
+          boolector_set_pp_pipeline (btor, po->valstr);
+          break;
 #if 0
               case BTORMAIN_OPT_DUMP_BTOR2:
                 dump = BTOR_OUTPUT_FORMAT_BTOR2;
@@ -1216,6 +1295,16 @@ boolector_main (int32_t argc, char **argv)
 
         case BTORMAIN_OPT_DUMP_AIGER_MERGE: dump_merge = true; break;
 
+        case BTORMAIN_OPT_DUMP_LEMMAS:
+          g_app->lemmas_outfile_name = po->valstr;
+          break;
+
+        case BTORMAIN_OPT_LOAD_LEMMAS:
+          g_app->lemmas_infile_name = po->valstr;
+          /* lemmas are asserted after parsing, solve first check-sat only */
+          boolector_set_opt (btor, BTOR_OPT_PARSE_INTERACTIVE, 0);
+          break;
+
         default:
           /* get rid of compiler warnings, should be unreachable */
           assert (bmopt == BTORMAIN_OPT_NUM_OPTS);
@@ -1463,6 +1552,34 @@ boolector_main (int32_t argc, char **argv)
     goto DONE;
   }
 
+  /* assert lemmas of a previous run */
+  if (g_app->lemmas_infile_name)
+  {
+    if (inc)
+    {
+      btormain_error (g_app, "can not load lemmas in incremental mode");
+      goto DONE;
+    }
+    lemmas_file = fopen (g_app->lemmas_infile_name, "r");
+    if (!lemmas_file)
+    {
+      btormain_error (g_app, "can not read '%s'", g_app->lemmas_infile_name);
+      goto DONE;
+    }
+    if (g_verbosity)
+      btormain_msg ("loading lemmas from '%s'", g_app->lemmas_infile_name);
+    parse_res = boolector_parse_lemmas_smt2 (
+        btor, lemmas_file, g_app->lemmas_infile_name, &parse_err_msg);
+    fclose (lemmas_file);
+    if (parse_res == BOOLECTOR_PARSE_ERROR)
+    {
+      fprintf (stderr, "boolector: %s\n", parse_err_msg);
+      g_app->err = BTOR_ERR_EXIT;
+      goto DONE;
+    }
+    assert (parse_res == BOOLECTOR_PARSE_UNKNOWN);
+  }
+
   /* incremental mode */
   if (inc)
   {
@@ -1479,6 +1596,8 @@ boolector_main (int32_t argc, char **argv)
 
     if (g_verbosity) boolector_print_stats (btor);
 
+    if (g_app->lemmas_outfile_name && !dump_lemmas (g_app)) goto DONE;
+
     if (pmodel && sat_res == BOOLECTOR_SAT)
     {
       assert (boolector_get_opt (btor, BTOR_OPT_MODEL_GEN));
@@ -1538,7 +1657,7 @@ boolector_main (int32_t argc, char **argv)
 
   /* call sat (if not yet called) */
   if (parse_res == BOOLECTOR_PARSE_UNKNOWN && !boolector_terminate (btor)
-      && !parsed_smt2)
+      && (!parsed_smt2 || g_app->lemmas_infile_name))
   {
     sat_res = boolector_sat (btor);
     print_sat_result (g_app, sat_res);
@@ -1566,6 +1685,8 @@ boolector_main (int32_t argc, char **argv)
     print_static_stats (sat_res);
   }
 
+  if (g_app->lemmas_outfile_name && !dump_lemmas (g_app)) goto DONE;
+
   /* print model */
   if (pmodel && sat_res == BOOLECTOR_SAT)
   {
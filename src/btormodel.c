@@ -13,6 +13,7 @@
 #include "btorclone.h"
 #include "btordbg.h"
 #include "btorlog.h"
+#include "preprocess/btorflatstore.h"
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btormem.h"
@@ -858,6 +859,33 @@ btor_model_recursively_compute_assignment (Btor *btor,
       if (result) goto PUSH_RESULT;
     }
 
+    /* if 'real_cur' is part of a flattened write chain, we directly evaluate
+     * the write that defines the value of 'cur_parent' (or the base array)
+     * instead of traversing the chain */
+    if (cur_parent && btor_node_is_apply (cur_parent)
+        && real_cur == cur_parent->e[0]
+        && btor_flatstore_contains (btor, real_cur)
+        && !btor_hashint_map_contains (mark, real_cur->id))
+    {
+      assert (btor_node_args_get_arity (btor, cur_parent->e[1]) == 1);
+      /* value of the index is on top of 'arg_stack' */
+      next = btor_flatstore_lookup (
+          btor, real_cur, (BtorBitVector *) BTOR_TOP_STACK (arg_stack));
+      assert (next);
+      if (btor_node_is_update (next))
+      {
+        BTOR_PUSH_STACK (work_stack, next->e[2]);
+        BTOR_PUSH_STACK (work_stack, next);
+        continue;
+      }
+      else if (next != real_cur)
+      {
+        BTOR_PUSH_STACK (work_stack, next);
+        BTOR_PUSH_STACK (work_stack, cur_parent);
+        continue;
+      }
+    }
+
     md = btor_hashint_map_get (mark, real_cur->id);
     if (!md)
     {
@@ -165,6 +165,16 @@ btor_opt_init_opts (Btor *btor)
                 BTOR_INCREMENTAL_SMT1_CONTINUE,
                 "solve all formulas");
   btor->options[BTOR_OPT_INCREMENTAL_SMT1].options = opts;
+  init_opt (btor,
+            BTOR_OPT_INCREMENTAL_PHASES,
+            false,
+            true,
+            "incremental-phases",
+            0,
+            1,
+            0,
+            1,
+            "use model of previous SAT call as phase hints");
 
   init_opt (btor,
             BTOR_OPT_INPUT_FORMAT,
@@ -551,6 +561,27 @@ btor_opt_init_opts (Btor *btor)
             1,
             "run sls engine as preprocessing within a sequential portfolio "
             "(QF_BV only)");
+  init_opt (btor,
+            BTOR_OPT_FUN_PRESCHED,
+            false,
+            true,
+            "fun-presched",
+            0,
+            1,
+            0,
+            1,
+            "interleave preprop/presls engine and SAT solver in time slices");
+  init_opt (btor,
+            BTOR_OPT_FUN_PREHYBRID,
+            false,
+            true,
+            "fun-prehybrid",
+            0,
+            0,
+            0,
+            1,
+            "bit-blast only persistently unsatisfied roots after "
+            "preprop/presls slices");
   init_opt (btor,
             BTOR_OPT_FUN_DUAL_PROP,
             false,
@@ -691,6 +722,28 @@ btor_opt_init_opts (Btor *btor)
       1,
       "Print CNF formula sent to SAT solver in DIMACS format and terminate.");
 
+  /* local search engines ------------------------------------------------ */
+  init_opt (btor,
+            BTOR_OPT_LS_NTHREADS,
+            false,
+            false,
+            "ls-nthreads",
+            0,
+            1,
+            1,
+            UINT32_MAX,
+            "number of local search workers (prop and sls engine)");
+  init_opt (btor,
+            BTOR_OPT_LS_ADAPTIVE,
+            false,
+            true,
+            "ls-adaptive",
+            0,
+            0,
+            0,
+            1,
+            "adapt noise and restarts of local search engines online");
+
   /* SLS engine ---------------------------------------------------------- */
   init_opt (btor,
             BTOR_OPT_SLS_NFLIPS,
@@ -1109,6 +1162,27 @@ btor_opt_init_opts (Btor *btor)
             1,
             "do not perform a propagation move when encountering a conflict"
             "during inverse computation");
+  init_opt (btor,
+            BTOR_OPT_PROP_NSAMPLES,
+            false,
+            false,
+            "prop-nsamples",
+            0,
+            1,
+            1,
+            64,
+            "number of inverse values sampled per propagation step "
+            "(bit-width <= 64)");
+  init_opt (btor,
+            BTOR_OPT_PROP_DOMAINS,
+            false,
+            true,
+            "prop-domains",
+            0,
+            1,
+            0,
+            1,
+            "use fixed-bit domains to guide propagated values");
 
   /* AIGPROP engine ------------------------------------------------------- */
   init_opt (btor,
@@ -1131,6 +1205,17 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "use bandit scheme for constraint selection");
+  init_opt (btor,
+            BTOR_OPT_AIGPROP_NSAMPLES,
+            false,
+            false,
+            "aigprop-nsamples",
+            0,
+            1,
+            1,
+            64,
+            "number of propagation moves sampled (and evaluated via "
+            "bit-parallel simulation) per move");
 
   /* QUANT engine ----------------------------------------------------------- */
   init_opt (btor,
@@ -1412,6 +1497,46 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "enable non-destructive term substitutions");
+  init_opt (btor,
+            BTOR_OPT_FLATTEN_STORES,
+            true,
+            true,
+            "flatten-stores",
+            0,
+            1,
+            0,
+            1,
+            "index chains of constant-index writes");
+  init_opt (btor,
+            BTOR_OPT_SIMP_BV_DOMAINS,
+            true,
+            true,
+            "simp-bv-domains",
+            0,
+            1,
+            0,
+            1,
+            "simplify based on fixed bits and unsigned intervals");
+  init_opt (btor,
+            BTOR_OPT_SIMP_BV_WIDTHS,
+            true,
+            true,
+            "simp-bv-widths",
+            0,
+            1,
+            0,
+            1,
+            "reduce the bit-width of zero and sign extended operations");
+  init_opt (btor,
+            BTOR_OPT_PP_PIPELINE,
+            true,
+            false,
+            "pp-pipeline",
+            0,
+            0,
+            0,
+            0,
+            "preprocessing pipeline (see boolector_set_pp_pipeline)");
 }
 
 void
@@ -1710,8 +1835,10 @@ btor_opt_set_str (Btor *btor, const BtorOption opt, const char *str)
 {
   assert (btor);
   assert (btor_opt_is_valid (btor, opt));
-  assert (opt == BTOR_OPT_SAT_ENGINE);
+  assert (opt == BTOR_OPT_SAT_ENGINE || opt == BTOR_OPT_PP_PIPELINE);
 
+  if (btor->options[opt].valstr)
+    btor_mem_freestr (btor->mm, btor->options[opt].valstr);
   btor->options[opt].valstr = btor_mem_strdup (btor->mm, str);
 }
 
@@ -333,3 +333,28 @@ btor_parse_smt2 (Btor *btor,
   return parse_aux (
       btor, infile, 0, infile_name, outfile, parser_api, error_msg, status, 0);
 }
+
+int32_t
+btor_parse_smt2_lemmas (Btor *btor,
+                        FILE *infile,
+                        const char *infile_name,
+                        char **error_msg)
+{
+  assert (btor);
+  assert (infile);
+  assert (infile_name);
+  assert (error_msg);
+
+  int32_t status;
+  const BtorParserAPI *parser_api;
+  parser_api = btor_parsesmt2_lemma_parser_api ();
+  return parse_aux (btor,
+                    infile,
+                    0,
+                    infile_name,
+                    stdout,
+                    parser_api,
+                    error_msg,
+                    &status,
+                    "parsing lemmas");
+}
@@ -87,5 +87,10 @@ int32_t btor_parse_smt2 (Btor *btor,
                          char **error_msg,
                          int32_t *status);
 
+int32_t btor_parse_smt2_lemmas (Btor *btor,
+                                FILE *infile,
+                                const char *infile_name,
+                                char **error_msg);
+
 BtorMsg *boolector_get_btor_msg (Btor *btor);
 #endif
@@ -8,6 +8,7 @@
 
 #include "btorproputils.h"
 
+#include "btorbvprop.h"
 #include "btorprintmodel.h"
 #include "btorslsutils.h"
 #include "utils/btornodeiter.h"
@@ -3449,10 +3450,312 @@ inv_cond_bv (Btor *btor,
   return res;
 }
 
+/* ========================================================================== */
+/* Sampled inverse values (bit-width <= 64)                                   */
+/* ========================================================================== */
+
+#define BTOR_PROP_MAX_NSAMPLES 64
+
+static inline uint64_t
+rand_uint64 (BtorRNG *rng, uint64_t mask)
+{
+  uint64_t res;
+  res = (uint64_t) btor_rng_rand (rng) << 32;
+  res |= btor_rng_rand (rng);
+  return res & mask;
+}
+
+/* random value in [from, to] */
+static inline uint64_t
+rand_range_uint64 (BtorRNG *rng, uint64_t from, uint64_t to)
+{
+  assert (from <= to);
+  uint64_t r = rand_uint64 (rng, UINT64_MAX);
+  if (to - from == UINT64_MAX) return r;
+  return from + r % (to - from + 1);
+}
+
+/* modular inverse of odd 'a' modulo 2^64 (Newton iteration, every step
+ * doubles the number of correct bits) */
+static uint64_t
+mod_inverse_uint64 (uint64_t a)
+{
+  assert (a & 1);
+  uint32_t i;
+  uint64_t res;
+  for (i = 0, res = a; i < 5; i++) res *= 2 - a * res;
+  assert (a * res == 1);
+  return res;
+}
+
+static uint32_t
+hamming_distance_uint64 (uint64_t a, uint64_t b)
+{
+  uint32_t res;
+  for (res = 0, a ^= b; a; a &= a - 1) res++;
+  return res;
+}
+
+/* Sample up to 'n' inverse values 'res' for e[eidx] of 'exp' with respect to
+ * target value 't' and assignment 's' of the other child, computed with
+ * native 64-bit arithmetic.  Returns the number of sampled values, which is
+ * 1 if the inverse value is unique, and 0 if 'exp' is not supported or there
+ * is no inverse value (conflict, handled by the generic inverse functions). */
+static uint32_t
+sample_inv_values_uint64 (Btor *btor,
+                          BtorNode *exp,
+                          uint64_t t,
+                          uint64_t s,
+                          int32_t eidx,
+                          uint64_t *res,
+                          uint32_t n)
+{
+  assert (btor);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+  assert (eidx >= 0 && eidx <= 1);
+  assert (res);
+  assert (n > 0 && n <= BTOR_PROP_MAX_NSAMPLES);
+
+  uint32_t i, j, bw;
+  uint64_t m, x, from, to;
+  BtorRNG *rng;
+
+  rng = &btor->rng;
+  bw  = btor_node_bv_get_width (btor, exp->e[eidx]);
+  assert (bw <= 64);
+  m = bw == 64 ? UINT64_MAX : ((uint64_t) 1 << bw) - 1;
+
+  switch (exp->kind)
+  {
+    /* x + s = s + x = t -> x = t - s (unique) */
+    case BTOR_BV_ADD_NODE: res[0] = (t - s) & m; return 1;
+
+    /* x & s = s & x = t -> bits where s = 0 are don't care bits,
+     * conflict if t = 1 and s = 0 for any bit */
+    case BTOR_BV_AND_NODE:
+      if (t & ~s) return 0;
+      for (i = 0; i < n; i++) res[i] = t | (rand_uint64 (rng, m) & ~s);
+      return n;
+
+    /* x = s -> t = 1: x = s (unique), t = 0: x != s */
+    case BTOR_BV_EQ_NODE:
+      if (t)
+      {
+        res[0] = s;
+        return 1;
+      }
+      for (i = 0; i < n; i++)
+      {
+        x      = rand_uint64 (rng, m);
+        res[i] = x == s ? x ^ 1 : x;
+      }
+      return n;
+
+    /* x < s = t, s < x = t -> x is from a range of values */
+    case BTOR_BV_ULT_NODE:
+      if (eidx)
+      {
+        if (t && s == m) return 0;
+        from = t ? s + 1 : 0;
+        to   = t ? m : s;
+      }
+      else
+      {
+        if (t && s == 0) return 0;
+        from = t ? 0 : s;
+        to   = t ? s - 1 : m;
+      }
+      for (i = 0; i < n; i++) res[i] = rand_range_uint64 (rng, from, to);
+      return n;
+
+    /* x * s = s * x = t
+     * -> s = 0: x is random if t = 0, else conflict
+     * -> s = 2^j * s', s' odd: conflict if t has less than j 0-LSBs, else
+     *    x = (t >> j) * s'^-1 with the j MSBs of x set randomly */
+    case BTOR_BV_MUL_NODE:
+      if (!s)
+      {
+        if (t) return 0;
+        for (i = 0; i < n; i++) res[i] = rand_uint64 (rng, m);
+        return n;
+      }
+      for (j = 0; !((s >> j) & 1); j++)
+        ;
+      if (t & (((uint64_t) 1 << j) - 1)) return 0;
+      x = ((t >> j) * mod_inverse_uint64 (s >> j)) & (m >> j);
+      if (!j)
+      {
+        res[0] = x;
+        return 1;
+      }
+      for (i = 0; i < n; i++) res[i] = x | (rand_uint64 (rng, m) & ~(m >> j));
+      return n;
+
+    default: return 0;
+  }
+}
+
+/* Fixed-bit domains of the current local search engine (0 if disabled). */
+static BtorIntHashTable *
+get_domains (Btor *btor)
+{
+  switch (btor_opt_get (btor, BTOR_OPT_ENGINE))
+  {
+    case BTOR_ENGINE_PROP: return BTOR_PROP_SOLVER (btor)->domains;
+    case BTOR_ENGINE_SLS: return BTOR_SLS_SOLVER (btor)->domains;
+    default: return 0;
+  }
+}
+
+/* Sample 'nsamples' inverse values for e[eidx] of 'exp' and select the one
+ * closest (Hamming distance) to its current assignment 'bvcur'.  Returns 0
+ * if no value was sampled (see sample_inv_values_uint64). */
+static BtorBitVector *
+inv_sample_bv (Btor *btor,
+               BtorNode *exp,
+               BtorBitVector *bvexp,
+               BtorBitVector *bve,
+               BtorBitVector *bvcur,
+               int32_t eidx,
+               uint32_t nsamples)
+{
+  assert (btor);
+  assert (exp);
+  assert (btor_node_is_regular (exp));
+  assert (bvexp);
+  assert (bve);
+  assert (bvcur);
+  assert (btor_bv_get_width (bvcur) <= 64);
+
+  uint32_t i, n, d, min, best;
+  uint64_t cur, lo, hi, samples[BTOR_PROP_MAX_NSAMPLES];
+  BtorBitVector *res;
+  BtorIntHashTable *domains;
+  BtorBvDomain *dom;
+
+  if (btor_node_is_bv_const (exp->e[eidx])) return 0;
+  if (btor_bv_get_width (bvexp) > 64) return 0; /* concat */
+
+  n = sample_inv_values_uint64 (btor,
+                                exp,
+                                btor_bv_to_uint64 (bvexp),
+                                btor_bv_to_uint64 (bve),
+                                eidx,
+                                samples,
+                                nsamples);
+  if (!n) return 0;
+
+  /* samples that violate fixed bits of e[eidx] are penalized */
+  lo = 0;
+  hi = UINT64_MAX;
+  if ((domains = get_domains (btor))
+      && (dom = btor_bvprop_get_domain (btor->mm, domains, exp->e[eidx])))
+  {
+    lo = btor_bv_to_uint64 (dom->lo);
+    hi = btor_bv_to_uint64 (dom->hi);
+    btor_bvprop_free (btor->mm, dom);
+  }
+
+  cur = btor_bv_to_uint64 (bvcur);
+  for (i = 0, best = 0, min = UINT32_MAX; i < n; i++)
+  {
+    d = hamming_distance_uint64 (samples[i], cur)
+        + 65 * hamming_distance_uint64 (samples[i], (samples[i] & hi) | lo);
+    if (d < min)
+    {
+      min  = d;
+      best = i;
+    }
+  }
+
+  if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
+    BTOR_PROP_SOLVER (btor)->stats.props_inv += 1;
+
+  res = btor_bv_uint64_to_bv (
+      btor->mm, samples[best], btor_bv_get_width (bvcur));
+#ifndef NDEBUG
+  BtorBitVector *(*fun) (
+      BtorMemMgr *, const BtorBitVector *, const BtorBitVector *);
+  char *op;
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE:
+      fun = btor_bv_add;
+      op  = "+";
+      break;
+    case BTOR_BV_AND_NODE:
+      fun = btor_bv_and;
+      op  = "AND";
+      break;
+    case BTOR_BV_EQ_NODE:
+      fun = btor_bv_eq;
+      op  = "=";
+      break;
+    case BTOR_BV_ULT_NODE:
+      fun = btor_bv_ult;
+      op  = "<";
+      break;
+    default:
+      assert (btor_node_is_bv_mul (exp));
+      fun = btor_bv_mul;
+      op  = "*";
+  }
+  check_result_binary_dbg (btor, fun, exp, bve, bvexp, res, eidx, op);
+#endif
+  return res;
+}
+
 /* ========================================================================== */
 /* Propagation move                                                           */
 /* ========================================================================== */
 
+/* Check if 'exp' evaluates to 'bvexp' if e[eidx] is assigned to 'value'. */
+static bool
+is_inv_value (Btor *btor,
+              BtorNode *exp,
+              BtorBitVector *bvexp,
+              BtorBitVector *bve[3],
+              int32_t eidx,
+              BtorBitVector *value)
+{
+  bool res;
+  BtorBitVector *e[3], *bv;
+  BtorMemMgr *mm;
+
+  mm   = btor->mm;
+  e[0] = bve[0];
+  e[1] = exp->arity > 1 ? bve[1] : 0;
+  e[2] = exp->arity > 2 ? bve[2] : 0;
+
+  e[eidx] = value;
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE: bv = btor_bv_add (mm, e[0], e[1]); break;
+    case BTOR_BV_AND_NODE: bv = btor_bv_and (mm, e[0], e[1]); break;
+    case BTOR_BV_EQ_NODE: bv = btor_bv_eq (mm, e[0], e[1]); break;
+    case BTOR_BV_ULT_NODE: bv = btor_bv_ult (mm, e[0], e[1]); break;
+    case BTOR_BV_SLL_NODE: bv = btor_bv_sll (mm, e[0], e[1]); break;
+    case BTOR_BV_SRL_NODE: bv = btor_bv_srl (mm, e[0], e[1]); break;
+    case BTOR_BV_MUL_NODE: bv = btor_bv_mul (mm, e[0], e[1]); break;
+    case BTOR_BV_UDIV_NODE: bv = btor_bv_udiv (mm, e[0], e[1]); break;
+    case BTOR_BV_UREM_NODE: bv = btor_bv_urem (mm, e[0], e[1]); break;
+    case BTOR_BV_CONCAT_NODE: bv = btor_bv_concat (mm, e[0], e[1]); break;
+    case BTOR_BV_SLICE_NODE:
+      bv = btor_bv_slice (mm,
+                          e[0],
+                          btor_node_bv_slice_get_upper (exp),
+                          btor_node_bv_slice_get_lower (exp));
+      break;
+    default:
+      assert (btor_node_is_bv_cond (exp));
+      bv = btor_bv_copy (mm, btor_bv_is_true (e[0]) ? e[1] : e[2]);
+  }
+  res = btor_bv_compare (bv, bvexp) == 0;
+  btor_bv_free (mm, bv);
+  return res;
+}
+
 static BtorNode *
 select_move (Btor *btor,
              BtorNode *exp,
@@ -3462,6 +3765,7 @@ select_move (Btor *btor,
                  Btor *, BtorNode *, BtorBitVector *, BtorBitVector **),
              BtorBitVector *(*compute_value) (
                  Btor *, BtorNode *, BtorBitVector *, BtorBitVector *, int32_t),
+             bool inv,
              BtorBitVector **value)
 {
   assert (btor);
@@ -3474,6 +3778,9 @@ select_move (Btor *btor,
   assert (value);
 
   int32_t eidx, idx;
+  uint32_t nsamples;
+  BtorIntHashTable *domains;
+  BtorBitVector *tmp;
 
   eidx = select_path (btor, exp, bvexp, bve);
   assert (eidx >= 0);
@@ -3481,7 +3788,33 @@ select_move (Btor *btor,
    * special case cond: we only need assignment of condition to compute value */
   idx = eidx ? 0
              : (btor_node_is_bv_slice (exp) || btor_node_is_cond (exp) ? 0 : 1);
-  *value = compute_value (btor, exp, bvexp, bve[idx], eidx);
+  *value   = 0;
+  nsamples = btor_opt_get (btor, BTOR_OPT_PROP_NSAMPLES);
+  if (inv && nsamples > 1 && exp->arity == 2
+      && btor_bv_get_width (bve[eidx]) <= 64)
+  {
+    *value =
+        inv_sample_bv (btor, exp, bvexp, bve[idx], bve[eidx], eidx, nsamples);
+  }
+  if (!*value) *value = compute_value (btor, exp, bvexp, bve[idx], eidx);
+
+  /* respect bits of e[eidx] that are fixed by the constraints, inverse
+   * values are only adjusted if they remain inverse values */
+  if (*value && (domains = get_domains (btor))
+      && (tmp = btor_bvprop_fix_bits (btor->mm, domains, exp->e[eidx], *value)))
+  {
+    if (inv && !is_inv_value (btor, exp, bvexp, bve, eidx, tmp))
+    {
+      btor_bv_free (btor->mm, tmp);
+    }
+    else
+    {
+      btor_bv_free (btor->mm, *value);
+      *value = tmp;
+      if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
+        BTOR_PROP_SOLVER (btor)->stats.props_dom += 1;
+    }
+  }
   return exp->e[eidx];
 }
 
@@ -3619,7 +3952,7 @@ btor_proputils_select_move_prop (Btor *btor,
       }
 
       cur = select_move (
-          btor, real_cur, bvcur, bve, select_path, compute_value, &bvenew);
+          btor, real_cur, bvcur, bve, select_path, compute_value, b, &bvenew);
       if (!bvenew) break; /* non-recoverable conflict */
 
       btor_bv_free (btor->mm, bvcur);
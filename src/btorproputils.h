@@ -22,6 +22,7 @@
 /*------------------------------------------------------------------------*/
 
 #define BTOR_PROPUTILS_PROB_FLIP_COND_CONST_DELTA 100
+#define BTOR_PROPUTILS_DOMAINS_MAX_ROUNDS 8
 
 /*------------------------------------------------------------------------*/
 
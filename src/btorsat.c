@@ -115,6 +115,12 @@ melt (BtorSATMgr *smgr, int32_t lit)
   // TODO: else case warning?
 }
 
+static inline void
+phase (BtorSATMgr *smgr, int32_t lit)
+{
+  if (smgr->api.phase) smgr->api.phase (smgr, lit);
+}
+
 static inline int32_t
 repr (BtorSATMgr *smgr, int32_t lit)
 {
@@ -457,6 +463,16 @@ btor_sat_fixed (BtorSATMgr *smgr, int32_t lit)
   return res;
 }
 
+void
+btor_sat_phase (BtorSATMgr *smgr, int32_t lit)
+{
+  assert (smgr != NULL);
+  assert (smgr->initialized);
+  assert (lit);
+  assert (abs (lit) <= smgr->maxvar);
+  phase (smgr, lit);
+}
+
 /*------------------------------------------------------------------------*/
 
 void
@@ -554,6 +570,13 @@ dimacs_printer_fixed (BtorSATMgr *smgr, int32_t lit)
   return fixed (printer->smgr, lit);
 }
 
+static void
+dimacs_printer_phase (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCnfPrinter *printer = (BtorCnfPrinter *) smgr->solver;
+  phase (printer->smgr, lit);
+}
+
 static void
 dimacs_printer_reset (BtorSATMgr *smgr)
 {
@@ -731,6 +754,7 @@ enable_dimacs_printer (BtorSATMgr *smgr)
   smgr->api.inc_max_var      = dimacs_printer_inc_max_var;
   smgr->api.init             = dimacs_printer_init;
   smgr->api.melt             = dimacs_printer_melt;
+  smgr->api.phase            = dimacs_printer_phase;
   smgr->api.repr             = dimacs_printer_repr;
   smgr->api.reset            = dimacs_printer_reset;
   smgr->api.sat              = dimacs_printer_sat;
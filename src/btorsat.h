@@ -66,6 +66,7 @@ struct BtorSATMgr
     int32_t (*inc_max_var) (BtorSATMgr *);
     void *(*init) (BtorSATMgr *); /* required */
     void (*melt) (BtorSATMgr *, int32_t);
+    void (*phase) (BtorSATMgr *, int32_t);
     int32_t (*repr) (BtorSATMgr *, int32_t);
     void (*reset) (BtorSATMgr *);           /* required */
     int32_t (*sat) (BtorSATMgr *, int32_t); /* required */
@@ -174,6 +175,12 @@ int32_t btor_sat_repr (BtorSATMgr *smgr, int32_t lit);
  */
 int32_t btor_sat_fixed (BtorSATMgr *smgr, int32_t lit);
 
+/* Sets the phase of the variable of a literal to the value of the literal,
+ * i.e., the value the SAT solver picks first when deciding on this variable.
+ * Phases are hints only and are ignored if not supported by the SAT solver.
+ */
+void btor_sat_phase (BtorSATMgr *smgr, int32_t lit);
+
 /* Resets the status of the SAT solver. */
 void btor_sat_reset (BtorSATMgr *smgr);
 
@@ -69,7 +69,7 @@ get_assignment_aig (AIGProp *aprop, BtorAIG *aig)
   if (aig == BTOR_AIG_TRUE) return 1;
   if (aig == BTOR_AIG_FALSE) return -1;
   /* initialize don't care bits with false */
-  if (!btor_hashint_map_contains (aprop->model, BTOR_REAL_ADDR_AIG (aig)->id))
+  if (!aigprop_has_assignment_aig (aprop, aig))
     return BTOR_IS_INVERTED_AIG (aig) ? 1 : -1;
   return aigprop_get_assignment_aig (aprop, aig);
 }
@@ -242,6 +242,7 @@ sat_aigprop_solver (BtorAIGPropSolver *slv)
   slv->aprop->seed         = btor_opt_get (btor, BTOR_OPT_SEED);
   slv->aprop->use_restarts = btor_opt_get (btor, BTOR_OPT_AIGPROP_USE_RESTARTS);
   slv->aprop->use_bandit   = btor_opt_get (btor, BTOR_OPT_AIGPROP_USE_BANDIT);
+  slv->aprop->nsamples     = btor_opt_get (btor, BTOR_OPT_AIGPROP_NSAMPLES);
 
   /* collect roots AIGs */
   roots = btor_hashint_table_new (btor->mm);
@@ -276,11 +277,7 @@ sat_aigprop_solver (BtorAIGPropSolver *slv)
   slv->time.aprop_update_cone_compute_score =
       slv->aprop->time.update_cone_compute_score;
 DONE:
-  if (slv->aprop->model)
-  {
-    btor_hashint_map_delete (slv->aprop->model);
-    slv->aprop->model = 0;
-  }
+  aigprop_delete_model (slv->aprop);
   if (roots) btor_hashint_table_delete (roots);
   return sat_result;
 }
@@ -372,7 +369,9 @@ btor_new_aigprop_solver (Btor *btor)
                            btor_opt_get (btor, BTOR_OPT_LOGLEVEL),
                            btor_opt_get (btor, BTOR_OPT_SEED),
                            btor_opt_get (btor, BTOR_OPT_AIGPROP_USE_RESTARTS),
-                           btor_opt_get (btor, BTOR_OPT_AIGPROP_USE_BANDIT));
+                           btor_opt_get (btor, BTOR_OPT_AIGPROP_USE_BANDIT),
+                           btor_opt_get (btor, BTOR_OPT_AIGPROP_NSAMPLES),
+                           btor_opt_get (btor, BTOR_OPT_LS_ADAPTIVE));
 
   BTOR_MSG (btor->msg, 1, "enabled aigprop engine");
 
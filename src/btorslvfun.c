@@ -10,6 +10,8 @@
 #include "btorslvfun.h"
 
 #include "btorabort.h"
+#include "btoraig.h"
+#include "btoraigvec.h"
 #include "btorbeta.h"
 #include "btorclone.h"
 #include "btorcore.h"
@@ -22,6 +24,7 @@
 #include "btorprintmodel.h"
 #include "btorslvprop.h"
 #include "btorslvsls.h"
+#include "preprocess/btorflatstore.h"
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 #include "utils/btornodeiter.h"
@@ -1756,6 +1759,27 @@ propagate (Btor *btor,
     /* skip array vars/uf */
     if (btor_node_is_uf (fun)) continue;
 
+    /* propagate directly to the write that defines the value of 'app' (or
+     * the base array) if 'fun' is part of a flattened write chain */
+    if (btor_flatstore_contains (btor, fun))
+    {
+      assert (btor_node_args_get_arity (btor, args) == 1);
+      bv  = get_bv_assignment (btor, args->e[0]);
+      cur = btor_flatstore_lookup (btor, fun, bv);
+      btor_bv_free (mm, bv);
+      assert (cur);
+      if (cur != fun)
+      {
+        BTORLOG (1, "  propagate down: %s", btor_util_node2string (app));
+        app->propagated = 0;
+        BTOR_PUSH_STACK (*prop_stack, app);
+        BTOR_PUSH_STACK (*prop_stack, cur);
+        slv->stats.propagations_down++;
+        slv->stats.propagations_flat_store++;
+        continue;
+      }
+    }
+
     if (btor_node_is_fun_cond (fun))
     {
       push_applies_for_propagation (
@@ -2406,6 +2430,737 @@ reset_lemma_cache (BtorFunSolver *slv)
                                         (BtorCmpPtr) btor_node_compare_by_id);
 }
 
+/*------------------------------------------------------------------------*/
+
+/* Initial budgets of the time slices of the preprop/presls scheduler:
+ * number of propagations (prop) or flips (sls) of the local search engine,
+ * number of conflicts of the SAT solver. */
+#define BTOR_FUN_PRESCHED_LS_BUDGET 10000
+#define BTOR_FUN_PRESCHED_SAT_BUDGET 1000
+
+/* Run the local search engine selected via --fun-preprop or --fun-presls.
+ * Starts from the current model if there is one (seeded by the scheduler),
+ * and from the all-zero assignment otherwise. */
+static BtorSolverResult
+sat_local_search (BtorFunSolver *slv)
+{
+  double start;
+  Btor *btor;
+  BtorSolver *preslv;
+  BtorOptEngine eopt;
+  BtorSolverResult result;
+
+  btor  = slv->btor;
+  start = btor_util_time_stamp ();
+
+  if (btor_opt_get (btor, BTOR_OPT_FUN_PREPROP))
+  {
+    preslv = btor_new_prop_solver (btor);
+    eopt   = BTOR_ENGINE_PROP;
+  }
+  else
+  {
+    preslv = btor_new_sls_solver (btor);
+    eopt   = BTOR_ENGINE_SLS;
+  }
+
+  btor->slv = preslv;
+  btor_opt_set (btor, BTOR_OPT_ENGINE, eopt);
+  result = btor->slv->api.sat (btor->slv);
+  /* print prop/sls solver statistics */
+  btor->slv->api.print_stats (btor->slv);
+  btor->slv->api.print_time_stats (btor->slv);
+  /* delete prop/sls solver */
+  btor->slv->api.delet (btor->slv);
+  /* reset */
+  btor->slv = (BtorSolver *) slv;
+  btor_opt_set (btor, BTOR_OPT_ENGINE, BTOR_ENGINE_FUN);
+  slv->time.presched_ls += btor_util_time_stamp () - start;
+  if (result == BTOR_RESULT_SAT || result == BTOR_RESULT_UNSAT)
+  {
+    BTOR_MSG (btor->msg, 1, "");
+    BTOR_MSG (btor->msg,
+              1,
+              "%s engine determined %s",
+              eopt == BTOR_ENGINE_PROP ? "PROP" : "SLS",
+              result == BTOR_RESULT_SAT ? "'sat'" : "'unsat'");
+  }
+  return result;
+}
+
+/* Get the number of roots that are false under the current model. */
+static uint32_t
+count_false_roots (Btor *btor)
+{
+  uint32_t res;
+  BtorNode *root;
+  BtorPtrHashTableIterator it;
+
+  res = 0;
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    root = btor_iter_hashptr_next (&it);
+    if (btor_bv_is_zero (btor_model_get_bv (btor, root))) res += 1;
+  }
+  return res;
+}
+
+/* Create a clone of the expression layer of 'btor' that runs the SAT slices
+ * of the scheduler. The SAT solver of 'btor' itself is not touched until the
+ * scheduler is done since the local search engines work on the unsynthesized
+ * formula only. Returns 0 if the SAT solver does not support incremental
+ * solving. */
+static Btor *
+new_presched_clone (Btor *btor, BtorNodeMap **exp_map)
+{
+  Btor *clone;
+  BtorSATMgr *smgr;
+
+  clone = btor_clone_exp_layer (btor, exp_map, false);
+  btor_opt_set (clone, BTOR_OPT_MODEL_GEN, 0);
+  btor_opt_set (clone, BTOR_OPT_INCREMENTAL, 1);
+  btor_opt_set (clone, BTOR_OPT_FUN_PREPROP, 0);
+  btor_opt_set (clone, BTOR_OPT_FUN_PRESLS, 0);
+  btor_opt_set (clone, BTOR_OPT_FUN_DUAL_PROP, 0);
+  btor_set_term (clone, btor->cbs.term.fun, btor->cbs.term.state);
+
+  smgr = btor_get_sat_mgr (clone);
+  assert (!btor_sat_is_initialized (smgr));
+  btor_sat_enable_solver (smgr);
+  if (!btor_sat_mgr_has_incremental_support (smgr))
+  {
+    btor_nodemap_delete (*exp_map);
+    *exp_map = 0;
+    btor_delete (clone);
+    return 0;
+  }
+  btor_sat_init (smgr);
+  return clone;
+}
+
+/* Get the assignment of 'var' in 'clone'. If 'fixed_only' is true, only bits
+ * fixed on the top level of the SAT solver are taken from 'clone', all other
+ * bits are taken from 'bv' (ownership is transferred to this function). */
+static BtorBitVector *
+get_presched_clone_assignment (Btor *clone,
+                               BtorNode *var,
+                               BtorBitVector *bv,
+                               bool fixed_only)
+{
+  int32_t val;
+  uint32_t i, j;
+  BtorAIG *aig;
+  BtorAIGVec *av;
+  BtorSATMgr *smgr;
+
+  assert (btor_node_is_regular (var));
+
+  if (!var->av) return bv;
+  if (!fixed_only)
+  {
+    btor_bv_free (clone->mm, bv);
+    return btor_bv_get_assignment (clone->mm, var);
+  }
+
+  smgr = btor_get_sat_mgr (clone);
+  av   = var->av;
+  assert (av->width == btor_bv_get_width (bv));
+  for (i = 0, j = av->width - 1; i < av->width; i++, j--)
+  {
+    aig = av->aigs[j];
+    if (btor_aig_is_const (aig))
+      val = btor_aig_is_true (aig) ? 1 : -1;
+    else if (!BTOR_REAL_ADDR_AIG (aig)->cnf_id)
+      continue;
+    else
+      val = btor_sat_fixed (smgr, btor_aig_get_cnf_id (aig));
+    if (val) btor_bv_set_bit (bv, i, val > 0 ? 1 : 0);
+  }
+  return bv;
+}
+
+/* Seed the model of 'btor' with the assignment of its inputs in 'clone'
+ * (partial, i.e., with top level units, if 'fixed_only' is true, in which
+ * case the current model provides the remaining bits). */
+static void
+seed_presched_model (Btor *btor,
+                     Btor *clone,
+                     BtorNodeMap *exp_map,
+                     bool fixed_only)
+{
+  uint32_t i;
+  BtorNode *var, *cvar;
+  BtorBitVector *bv;
+  BtorPtrHashTableIterator it;
+  BtorNodePtrStack vars;
+  BtorVoidPtrStack values;
+
+  BTOR_INIT_STACK (btor->mm, vars);
+  BTOR_INIT_STACK (btor->mm, values);
+  btor_iter_hashptr_init (&it, btor->bv_vars);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    var = btor_node_get_simplified (btor, btor_iter_hashptr_next (&it));
+    if (!btor_node_is_regular (var) || !btor_node_is_bv_var (var)) continue;
+    if (btor->bv_model)
+      bv = btor_bv_copy (btor->mm, btor_model_get_bv (btor, var));
+    else
+      bv = btor_bv_new (btor->mm, btor_node_bv_get_width (btor, var));
+    cvar = btor_nodemap_mapped (exp_map, var);
+    if (cvar)
+      bv = get_presched_clone_assignment (
+          clone, btor_node_real_addr (cvar), bv, fixed_only);
+    BTOR_PUSH_STACK (vars, var);
+    BTOR_PUSH_STACK (values, bv);
+  }
+
+  btor_model_init_bv (btor, &btor->bv_model);
+  btor_model_init_fun (btor, &btor->fun_model);
+  for (i = 0; i < BTOR_COUNT_STACK (vars); i++)
+  {
+    var = BTOR_PEEK_STACK (vars, i);
+    bv  = BTOR_PEEK_STACK (values, i);
+    if (!btor_hashint_map_contains (btor->bv_model, var->id))
+      btor_model_add_to_bv (btor, btor->bv_model, var, bv);
+    btor_bv_free (btor->mm, bv);
+  }
+  btor_model_generate (btor, btor->bv_model, btor->fun_model, false);
+  BTOR_RELEASE_STACK (vars);
+  BTOR_RELEASE_STACK (values);
+}
+
+/* Pass the assignment of the last local search slice to the SAT solver of
+ * 'clone' as phases, the next SAT slice thus starts its search from there. */
+static void
+add_presched_phase_hints (Btor *btor, Btor *clone, BtorNodeMap *exp_map)
+{
+  BtorNode *var, *cvar;
+  BtorPtrHashTableIterator it;
+
+  assert (btor->bv_model);
+
+  btor_iter_hashptr_init (&it, btor->bv_vars);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    var = btor_node_get_simplified (btor, btor_iter_hashptr_next (&it));
+    if (!btor_node_is_regular (var) || !btor_node_is_bv_var (var)) continue;
+    cvar = btor_nodemap_mapped (exp_map, var);
+    if (!cvar) continue;
+    assert (btor_node_is_regular (cvar));
+    btor_set_phase_hint (clone, cvar, btor_model_get_bv (btor, var));
+  }
+  btor_add_phase_hints (clone);
+}
+
+/* Interleave the local search engine and the SAT solver in time slices. Each
+ * local search slice starts from the assignment of the previous one, with
+ * the bits fixed by the SAT solver in the previous SAT slice applied. The
+ * budget of the SAT solver doubles each round, the budget of the local search
+ * engine only while it reduces the number of unsatisfied roots. */
+static BtorSolverResult
+sat_presched (BtorFunSolver *slv)
+{
+  double start;
+  uint32_t ls_budget, ls_budget_opt, nroots, min_nroots;
+  int32_t sat_budget;
+  Btor *btor, *clone;
+  BtorNodeMap *exp_map;
+  BtorOption bopt;
+  BtorSATMgr *smgr;
+  BtorSolverResult result;
+
+  btor    = slv->btor;
+  exp_map = 0;
+  clone   = new_presched_clone (btor, &exp_map);
+  if (!clone)
+    BTOR_MSG (btor->msg,
+              1,
+              "SAT solver not incremental, disable --fun-presched");
+
+  bopt          = btor_opt_get (btor, BTOR_OPT_FUN_PREPROP)
+                      ? BTOR_OPT_PROP_NPROPS
+                      : BTOR_OPT_SLS_NFLIPS;
+  ls_budget_opt = btor_opt_get (btor, bopt);
+  ls_budget     = ls_budget_opt ? ls_budget_opt : BTOR_FUN_PRESCHED_LS_BUDGET;
+  sat_budget    = BTOR_FUN_PRESCHED_SAT_BUDGET;
+  min_nroots    = UINT32_MAX;
+
+  btor_model_delete (btor);
+  for (;;)
+  {
+    /* local search slice */
+    if (clone) btor_opt_set (btor, bopt, ls_budget);
+    result = sat_local_search (slv);
+    slv->stats.presched_ls_slices += 1;
+    if (result != BTOR_RESULT_UNKNOWN || !clone || btor_terminate (btor))
+      break;
+
+    nroots = count_false_roots (btor);
+    BTOR_MSG (btor->msg,
+              1,
+              "local search slice %u: %u unsatisfied roots (budget %u)",
+              slv->stats.presched_ls_slices,
+              nroots,
+              ls_budget);
+    if (nroots < min_nroots)
+    {
+      min_nroots = nroots;
+      ls_budget  = ls_budget > UINT32_MAX / 2 ? UINT32_MAX : 2 * ls_budget;
+    }
+
+    /* SAT slice */
+    start = btor_util_time_stamp ();
+    btor_process_unsynthesized_constraints (clone);
+    if (clone->found_constraint_false)
+      result = BTOR_RESULT_UNSAT;
+    else
+    {
+      smgr = btor_get_sat_mgr (clone);
+      btor_add_again_assumptions (clone);
+      add_presched_phase_hints (btor, clone, exp_map);
+      result = btor_sat_check_sat (smgr, sat_budget);
+    }
+    slv->time.presched_sat += btor_util_time_stamp () - start;
+    slv->stats.presched_sat_slices += 1;
+    BTOR_MSG (btor->msg,
+              1,
+              "SAT slice %u: %s (budget %d)",
+              slv->stats.presched_sat_slices,
+              result == BTOR_RESULT_SAT
+                  ? "sat"
+                  : (result == BTOR_RESULT_UNSAT ? "unsat" : "unknown"),
+              sat_budget);
+
+    if (result == BTOR_RESULT_SAT)
+    {
+      seed_presched_model (btor, clone, exp_map, false);
+      assert (count_false_roots (btor) == 0);
+    }
+    if (result == BTOR_RESULT_SAT || result == BTOR_RESULT_UNSAT)
+    {
+      BTOR_MSG (btor->msg, 1, "");
+      BTOR_MSG (btor->msg,
+                1,
+                "SAT solver determined %s",
+                result == BTOR_RESULT_SAT ? "'sat'" : "'unsat'");
+      /* failed assumptions are determined via the LOD loop */
+      if (result == BTOR_RESULT_UNSAT && btor->assumptions->count)
+        result = BTOR_RESULT_UNKNOWN;
+      break;
+    }
+    if (btor_terminate (btor)) break;
+    sat_budget = sat_budget > INT32_MAX / 2 ? INT32_MAX : 2 * sat_budget;
+
+    /* start next local search slice from current assignment with bits
+     * fixed by the SAT solver */
+    seed_presched_model (btor, clone, exp_map, true);
+  }
+
+  btor_opt_set (btor, bopt, ls_budget_opt);
+  if (clone)
+  {
+    btor_nodemap_delete (exp_map);
+    btor_delete (clone);
+  }
+  return result;
+}
+
+/* A root is bit-blasted by the hybrid scheduler if it is unsatisfied after
+ * this many consecutive local search slices. */
+#define BTOR_FUN_PREHYBRID_PERSIST 2
+/* Give up (and fall back to bit-blasting the whole formula) if the minimum
+ * number of unsatisfied roots did not decrease for this many rounds. */
+#define BTOR_FUN_PREHYBRID_MAX_STALLS 4
+
+/* Collect the ids of the bit-vector variables in the cones of 'roots'. */
+static void
+collect_prehybrid_vars (Btor *btor,
+                        BtorNodePtrStack *roots,
+                        BtorIntHashTable *vars)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *cache;
+
+  BTOR_INIT_STACK (btor->mm, visit);
+  cache = btor_hashint_table_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+    BTOR_PUSH_STACK (visit, BTOR_PEEK_STACK (*roots, i));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    if (btor_node_is_bv_var (cur))
+    {
+      if (!btor_hashint_table_contains (vars, cur->id))
+        btor_hashint_table_add (vars, cur->id);
+      continue;
+    }
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  btor_hashint_table_delete (cache);
+  BTOR_RELEASE_STACK (visit);
+}
+
+/* Update the number of consecutive slices each root in 'roots' has been
+ * unsatisfied under the current model. Roots that are unsatisfied for at
+ * least 'limit' slices are pushed onto 'hard'. Returns the number of
+ * unsatisfied roots. */
+static uint32_t
+update_prehybrid_hard (BtorFunSolver *slv,
+                       BtorNodePtrStack *roots,
+                       BtorIntHashTable *persist,
+                       BtorNodePtrStack *hard,
+                       int32_t limit)
+{
+  int32_t id;
+  uint32_t i, res;
+  Btor *btor;
+  BtorNode *root;
+  BtorHashTableData *d;
+
+  btor = slv->btor;
+  for (i = 0, res = 0; i < BTOR_COUNT_STACK (*roots); i++)
+  {
+    root = BTOR_PEEK_STACK (*roots, i);
+    id   = btor_node_get_id (root);
+    d    = btor_hashint_map_get (persist, id);
+    if (!btor_bv_is_zero (btor_model_get_bv (btor, root)))
+    {
+      if (d && d->as_int > 0) d->as_int = 0;
+      continue;
+    }
+    res += 1;
+    if (!d)
+    {
+      d         = btor_hashint_map_add (persist, id);
+      d->as_int = 0;
+    }
+    if (d->as_int < 0) continue; /* already hard */
+    d->as_int += 1;
+    if (d->as_int >= limit)
+    {
+      d->as_int = -1;
+      BTOR_PUSH_STACK (*hard, root);
+      slv->stats.prehybrid_roots += 1;
+    }
+  }
+  return res;
+}
+
+/* Check the roots in 'hard' with the SAT solver of 'clone' under the current
+ * model of 'btor' for the variables in 'fixed' (via assumptions), except for
+ * the variables in 'freed'. If the check fails due to the assumptions on some
+ * variables, these are added to 'freed' and the check is repeated. */
+static BtorSolverResult
+check_prehybrid (BtorFunSolver *slv,
+                 Btor *clone,
+                 BtorNodeMap *exp_map,
+                 BtorNodePtrStack *hard,
+                 BtorIntHashTable *fixed,
+                 BtorIntHashTable *freed,
+                 int32_t sat_budget)
+{
+  int32_t id, lit;
+  uint32_t i, j, k, nfreed;
+  Btor *btor;
+  BtorNode *var, *cvar;
+  BtorAIG *aig;
+  BtorAIGVec *av;
+  BtorAIGMgr *amgr;
+  BtorSATMgr *smgr;
+  const BtorBitVector *bv;
+  BtorIntHashTableIterator it;
+  BtorIntStack lits, lit_vars;
+  BtorSolverResult result;
+
+  btor = slv->btor;
+  amgr = btor_get_aig_mgr (clone);
+  smgr = btor_get_sat_mgr (clone);
+  BTOR_INIT_STACK (btor->mm, lits);
+  BTOR_INIT_STACK (btor->mm, lit_vars);
+
+  for (;;)
+  {
+    result = BTOR_RESULT_UNKNOWN;
+    BTOR_RESET_STACK (lits);
+    BTOR_RESET_STACK (lit_vars);
+
+    for (i = 0; i < BTOR_COUNT_STACK (*hard); i++)
+    {
+      av  = btor_exp_to_aigvec (clone,
+                               btor_nodemap_mapped (exp_map,
+                                                    BTOR_PEEK_STACK (*hard, i)),
+                               0);
+      aig = av->aigs[0];
+      if (aig == BTOR_AIG_FALSE) result = BTOR_RESULT_UNSAT;
+      if (!btor_aig_is_const (aig))
+      {
+        btor_aig_to_sat (amgr, aig);
+        btor_sat_assume (smgr, btor_aig_get_cnf_id (aig));
+      }
+      btor_aigvec_release_delete (clone->avmgr, av);
+    }
+    if (result == BTOR_RESULT_UNSAT) break;
+
+    btor_iter_hashint_init (&it, fixed);
+    while (btor_iter_hashint_has_next (&it))
+    {
+      id = btor_iter_hashint_next (&it);
+      if (btor_hashint_table_contains (freed, id)) continue;
+      var  = btor_node_get_by_id (btor, id);
+      cvar = btor_nodemap_mapped (exp_map, var);
+      if (!cvar || !btor_node_real_addr (cvar)->av) continue;
+      assert (btor_node_is_regular (cvar));
+      av = cvar->av;
+      bv = btor_model_get_bv (btor, var);
+      for (j = 0, k = av->width - 1; j < av->width; j++, k--)
+      {
+        aig = av->aigs[k];
+        if (btor_aig_is_const (aig) || !btor_aig_get_cnf_id (aig)) continue;
+        lit = btor_aig_get_cnf_id (aig);
+        if (!btor_bv_get_bit (bv, j)) lit = -lit;
+        btor_sat_assume (smgr, lit);
+        BTOR_PUSH_STACK (lits, lit);
+        BTOR_PUSH_STACK (lit_vars, id);
+      }
+    }
+
+    add_presched_phase_hints (btor, clone, exp_map);
+    result = btor_sat_check_sat (smgr, sat_budget);
+    if (result != BTOR_RESULT_UNSAT) break;
+
+    /* release variables in conflict with the hard roots */
+    for (i = 0, nfreed = 0; i < BTOR_COUNT_STACK (lits); i++)
+    {
+      id = BTOR_PEEK_STACK (lit_vars, i);
+      if (btor_hashint_table_contains (freed, id)) continue;
+      if (!btor_sat_failed (smgr, BTOR_PEEK_STACK (lits, i))) continue;
+      btor_hashint_table_add (freed, id);
+      slv->stats.prehybrid_freed += 1;
+      nfreed += 1;
+    }
+    if (!nfreed) break;
+    if (btor_terminate (btor))
+    {
+      result = BTOR_RESULT_UNKNOWN;
+      break;
+    }
+  }
+
+  BTOR_RELEASE_STACK (lits);
+  BTOR_RELEASE_STACK (lit_vars);
+  return result;
+}
+
+/* Run a SAT slice on the roots in 'hard', with all inputs that are shared
+ * with the remaining roots fixed to the current model (except for the inputs
+ * in 'freed'). */
+static BtorSolverResult
+sat_prehybrid_slice (BtorFunSolver *slv,
+                     Btor *clone,
+                     BtorNodeMap *exp_map,
+                     BtorNodePtrStack *roots,
+                     BtorIntHashTable *persist,
+                     BtorNodePtrStack *hard,
+                     BtorIntHashTable *freed,
+                     int32_t sat_budget)
+{
+  double start;
+  int32_t id;
+  uint32_t i, nfixed;
+  Btor *btor;
+  BtorNode *root;
+  BtorHashTableData *d;
+  BtorIntHashTableIterator it;
+  BtorNodePtrStack easy;
+  BtorIntHashTable *hard_vars, *easy_vars, *fixed;
+  BtorSolverResult result;
+
+  btor = slv->btor;
+
+  BTOR_INIT_STACK (btor->mm, easy);
+  for (i = 0; i < BTOR_COUNT_STACK (*roots); i++)
+  {
+    root = BTOR_PEEK_STACK (*roots, i);
+    d    = btor_hashint_map_get (persist, btor_node_get_id (root));
+    if (!d || d->as_int >= 0) BTOR_PUSH_STACK (easy, root);
+  }
+  hard_vars = btor_hashint_table_new (btor->mm);
+  easy_vars = btor_hashint_table_new (btor->mm);
+  fixed     = btor_hashint_table_new (btor->mm);
+  collect_prehybrid_vars (btor, hard, hard_vars);
+  collect_prehybrid_vars (btor, &easy, easy_vars);
+  btor_iter_hashint_init (&it, hard_vars);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    id = btor_iter_hashint_next (&it);
+    if (btor_hashint_table_contains (easy_vars, id)
+        && !btor_hashint_table_contains (freed, id))
+      btor_hashint_table_add (fixed, id);
+  }
+
+  start  = btor_util_time_stamp ();
+  result =
+      check_prehybrid (slv, clone, exp_map, hard, fixed, freed, sat_budget);
+  slv->time.presched_sat += btor_util_time_stamp () - start;
+  slv->stats.presched_sat_slices += 1;
+
+  btor_iter_hashint_init (&it, fixed);
+  for (nfixed = 0; btor_iter_hashint_has_next (&it);)
+    if (!btor_hashint_table_contains (freed, btor_iter_hashint_next (&it)))
+      nfixed += 1;
+  BTOR_MSG (btor->msg,
+            1,
+            "SAT slice %u: %s (budget %d, %u hard roots, %u/%u inputs fixed)",
+            slv->stats.presched_sat_slices,
+            result == BTOR_RESULT_SAT
+                ? "sat"
+                : (result == BTOR_RESULT_UNSAT ? "unsat" : "unknown"),
+            sat_budget,
+            BTOR_COUNT_STACK (*hard),
+            nfixed,
+            hard_vars->count);
+
+  btor_hashint_table_delete (hard_vars);
+  btor_hashint_table_delete (easy_vars);
+  btor_hashint_table_delete (fixed);
+  BTOR_RELEASE_STACK (easy);
+  return result;
+}
+
+/* Alternate between local search slices and SAT slices on the hard part of
+ * the formula, i.e., the roots that are unsatisfied after at least
+ * BTOR_FUN_PREHYBRID_PERSIST consecutive local search slices. Only the cones
+ * of the hard roots are bit-blasted, inputs shared with the remaining roots
+ * are fixed to the assignment of the local search engine (and released on
+ * conflict). Roots that are unsatisfied under the assignment of a SAT slice
+ * become hard, i.e., the SAT slices are repeated until either all roots are
+ * satisfied or the hard part is unsatisfiable. If the SAT slice runs out of
+ * budget, the next local search slice starts from the current assignment. */
+static BtorSolverResult
+sat_prehybrid (BtorFunSolver *slv)
+{
+  uint32_t ls_budget, ls_budget_opt, nroots, min_nroots, nstalls;
+  int32_t sat_budget;
+  Btor *btor, *clone;
+  BtorNodeMap *exp_map;
+  BtorOption bopt;
+  BtorSolverResult result;
+  BtorPtrHashTableIterator it;
+  BtorNodePtrStack roots, hard;
+  BtorIntHashTable *persist, *freed;
+
+  assert (slv->btor->synthesized_constraints->count == 0);
+
+  btor    = slv->btor;
+  exp_map = 0;
+  clone   = new_presched_clone (btor, &exp_map);
+  if (!clone)
+    BTOR_MSG (btor->msg,
+              1,
+              "SAT solver not incremental, disable --fun-prehybrid");
+
+  bopt          = btor_opt_get (btor, BTOR_OPT_FUN_PREPROP)
+                      ? BTOR_OPT_PROP_NPROPS
+                      : BTOR_OPT_SLS_NFLIPS;
+  ls_budget_opt = btor_opt_get (btor, bopt);
+  ls_budget     = ls_budget_opt ? ls_budget_opt : BTOR_FUN_PRESCHED_LS_BUDGET;
+  sat_budget    = BTOR_FUN_PRESCHED_SAT_BUDGET;
+  min_nroots    = UINT32_MAX;
+  nstalls       = 0;
+
+  BTOR_INIT_STACK (btor->mm, roots);
+  BTOR_INIT_STACK (btor->mm, hard);
+  persist = btor_hashint_map_new (btor->mm);
+  freed   = btor_hashint_table_new (btor->mm);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (roots, btor_iter_hashptr_next (&it));
+
+  btor_model_delete (btor);
+  for (;;)
+  {
+    /* local search slice */
+    if (clone) btor_opt_set (btor, bopt, ls_budget);
+    result = sat_local_search (slv);
+    slv->stats.presched_ls_slices += 1;
+    if (result != BTOR_RESULT_UNKNOWN || !clone || btor_terminate (btor))
+      break;
+
+    nroots = update_prehybrid_hard (
+        slv, &roots, persist, &hard, BTOR_FUN_PREHYBRID_PERSIST);
+    BTOR_MSG (btor->msg,
+              1,
+              "local search slice %u: %u unsatisfied roots, %u hard "
+              "(budget %u)",
+              slv->stats.presched_ls_slices,
+              nroots,
+              BTOR_COUNT_STACK (hard),
+              ls_budget);
+    if (nroots < min_nroots)
+    {
+      min_nroots = nroots;
+      nstalls    = 0;
+      ls_budget  = ls_budget > UINT32_MAX / 2 ? UINT32_MAX : 2 * ls_budget;
+    }
+    else if (++nstalls > BTOR_FUN_PREHYBRID_MAX_STALLS)
+    {
+      BTOR_MSG (btor->msg, 1, "no progress, disable --fun-prehybrid");
+      break;
+    }
+    if (BTOR_EMPTY_STACK (hard)) continue;
+
+    /* SAT slices, roots that are unsatisfied under the assignment of the
+     * SAT solver become hard immediately */
+    do
+    {
+      result = sat_prehybrid_slice (
+          slv, clone, exp_map, &roots, persist, &hard, freed, sat_budget);
+      if (result != BTOR_RESULT_SAT) break;
+      /* next slice starts from the assignment of the SAT solver */
+      seed_presched_model (btor, clone, exp_map, false);
+      nroots = update_prehybrid_hard (slv, &roots, persist, &hard, 1);
+    } while (nroots > 0 && !btor_terminate (btor));
+
+    if (result == BTOR_RESULT_SAT && nroots == 0)
+    {
+      BTOR_MSG (btor->msg, 1, "");
+      BTOR_MSG (btor->msg, 1, "SAT solver determined 'sat'");
+      break;
+    }
+    if (result == BTOR_RESULT_UNSAT)
+    {
+      /* the hard roots alone are unsatisfiable */
+      BTOR_MSG (btor->msg, 1, "");
+      BTOR_MSG (btor->msg, 1, "SAT solver determined 'unsat'");
+      /* failed assumptions are determined via the LOD loop */
+      if (btor->assumptions->count) result = BTOR_RESULT_UNKNOWN;
+      break;
+    }
+    result = BTOR_RESULT_UNKNOWN;
+    if (btor_terminate (btor)) break;
+    sat_budget = sat_budget > INT32_MAX / 2 ? INT32_MAX : 2 * sat_budget;
+  }
+
+  btor_opt_set (btor, bopt, ls_budget_opt);
+  BTOR_RELEASE_STACK (roots);
+  BTOR_RELEASE_STACK (hard);
+  btor_hashint_map_delete (persist);
+  btor_hashint_table_delete (freed);
+  if (clone)
+  {
+    btor_nodemap_delete (exp_map);
+    btor_delete (clone);
+  }
+  return result;
+}
+
 static BtorSolverResult
 sat_fun_solver (BtorFunSolver *slv)
 {
@@ -2415,7 +3170,6 @@ sat_fun_solver (BtorFunSolver *slv)
   assert (slv->btor->slv == (BtorSolver *) slv);
 
   uint32_t i;
-  bool done;
   BtorSolverResult result;
   Btor *btor, *clone;
   BtorNode *clone_root, *lemma;
@@ -2436,46 +3190,23 @@ sat_fun_solver (BtorFunSolver *slv)
   exp_map    = 0;
 
   if ((btor_opt_get (btor, BTOR_OPT_FUN_PREPROP)
-       || btor_opt_get (btor, BTOR_OPT_FUN_PRESLS))
+       /* sls engine does not support synthesized constraints (incremental) */
+       || (btor_opt_get (btor, BTOR_OPT_FUN_PRESLS)
+           && btor->synthesized_constraints->count == 0))
       && btor->ufs->count == 0 && btor->feqs->count == 0
       && btor->lambdas->count == 0)
   {
-    BtorSolver *preslv;
-    BtorOptEngine eopt;
-
-    if (btor_opt_get (btor, BTOR_OPT_FUN_PREPROP))
-    {
-      preslv = btor_new_prop_solver (btor);
-      eopt   = BTOR_ENGINE_PROP;
-    }
+    if (btor_opt_get (btor, BTOR_OPT_FUN_PREHYBRID)
+        && btor->synthesized_constraints->count == 0)
+      result = sat_prehybrid (slv);
+    else if (btor_opt_get (btor, BTOR_OPT_FUN_PRESCHED))
+      result = sat_presched (slv);
     else
     {
-      preslv = btor_new_sls_solver (btor);
-      eopt   = BTOR_ENGINE_SLS;
-    }
-
-    btor->slv = preslv;
-    btor_opt_set (btor, BTOR_OPT_ENGINE, eopt);
-    result = btor->slv->api.sat (btor->slv);
-    done   = result == BTOR_RESULT_SAT || result == BTOR_RESULT_UNSAT;
-    /* print prop/sls solver statistics */
-    btor->slv->api.print_stats (btor->slv);
-    btor->slv->api.print_time_stats (btor->slv);
-    /* delete prop/sls solver */
-    btor->slv->api.delet (btor->slv);
-    /* reset */
-    btor->slv = (BtorSolver *) slv;
-    btor_opt_set (btor, BTOR_OPT_ENGINE, BTOR_ENGINE_FUN);
-    if (done)
-    {
-      BTOR_MSG (btor->msg, 1, "");
-      BTOR_MSG (btor->msg,
-                1,
-                "%s engine determined %s",
-                eopt == BTOR_ENGINE_PROP ? "PROP" : "SLS",
-                result == BTOR_RESULT_SAT ? "'sat'" : "'unsat'");
-      goto DONE;
+      btor_model_delete (btor);
+      result = sat_local_search (slv);
     }
+    if (result == BTOR_RESULT_SAT || result == BTOR_RESULT_UNSAT) goto DONE;
     /* reset */
     btor_model_delete (btor);
   }
@@ -2521,6 +3252,7 @@ sat_fun_solver (BtorFunSolver *slv)
 
     /* make SAT call on bv skeleton */
     btor_add_again_assumptions (btor);
+    btor_add_phase_hints (btor);
     result = timed_sat_sat (btor, slv->sat_limit);
 
     if (result == BTOR_RESULT_UNSAT)
@@ -2678,6 +3410,27 @@ print_stats_fun_solver (BtorFunSolver *slv)
   BTOR_MSG (btor->msg, 1, "%7lld propagations", slv->stats.propagations);
   BTOR_MSG (
       btor->msg, 1, "%7lld propagations down", slv->stats.propagations_down);
+  BTOR_MSG (btor->msg,
+            1,
+            "%7lld propagations over flattened write chains",
+            slv->stats.propagations_flat_store);
+
+  if (slv->stats.presched_ls_slices)
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%d/%d local search/SAT slices (preprop/presls scheduler)",
+              slv->stats.presched_ls_slices,
+              slv->stats.presched_sat_slices);
+  }
+  if (slv->stats.prehybrid_roots)
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%d/%d hard roots/released inputs (hybrid scheduler)",
+              slv->stats.prehybrid_roots,
+              slv->stats.prehybrid_freed);
+  }
 
   if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
   {
@@ -2781,6 +3534,15 @@ print_time_stats_fun_solver (BtorFunSolver *slv)
             slv->time.prop_cleanup);
 
   BTOR_MSG (btor->msg, 1, "%.2f seconds in pure SAT solving", slv->time.sat);
+  if (slv->stats.presched_ls_slices)
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "%.2f seconds in local search slices",
+              slv->time.presched_ls);
+    BTOR_MSG (
+        btor->msg, 1, "%.2f seconds in SAT slices", slv->time.presched_sat);
+  }
   BTOR_MSG (btor->msg, 1, "");
 }
 
@@ -2826,6 +3588,29 @@ btor_new_fun_solver (Btor *btor)
   return (BtorSolver *) slv;
 }
 
+void
+btor_fun_solver_get_lemmas (Btor *btor, BtorNodePtrStack *lemmas)
+{
+  assert (btor);
+  assert (lemmas);
+
+  size_t n;
+  BtorFunSolver *slv;
+  BtorPtrHashTableIterator it;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  if (!slv || slv->kind != BTOR_FUN_SOLVER_KIND) return;
+
+  n = BTOR_COUNT_STACK (*lemmas);
+  btor_iter_hashptr_init (&it, slv->lemmas);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (*lemmas, btor_iter_hashptr_next (&it));
+  qsort (lemmas->start + n,
+         BTOR_COUNT_STACK (*lemmas) - n,
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+}
+
 // TODO (ma): this is just a fix for now, this should be moved elsewhere
 BtorBitVector *
 btor_eval_exp (Btor *btor, BtorNode *exp)
@@ -54,6 +54,12 @@ struct BtorFunSolver
     uint_least64_t eval_exp_calls;
     uint_least64_t propagations;
     uint_least64_t propagations_down;
+    uint_least64_t propagations_flat_store;
+
+    uint32_t presched_ls_slices;  /* local search slices (--fun-presched) */
+    uint32_t presched_sat_slices; /* SAT slices (--fun-presched) */
+    uint32_t prehybrid_roots;     /* bit-blasted roots (--fun-prehybrid) */
+    uint32_t prehybrid_freed;     /* inputs released from fixing */
   } stats;
 
   struct
@@ -76,6 +82,8 @@ struct BtorFunSolver
     double find_conf_app;
     double check_extensionality;
     double prop_cleanup;
+    double presched_ls;
+    double presched_sat;
   } time;
 };
 
@@ -83,6 +91,11 @@ typedef struct BtorFunSolver BtorFunSolver;
 
 BtorSolver *btor_new_fun_solver (Btor *btor);
 
+/* Push all lemmas generated by the fun solver (ordered by id) onto 'lemmas'.
+ * Lemmas are valid in the theory of arrays and uninterpreted functions, i.e.,
+ * they are independent from the input formula. */
+void btor_fun_solver_get_lemmas (Btor *btor, BtorNodePtrStack *lemmas);
+
 // TODO (ma): this is just a fix for now, this should be moved elsewhere
 /* Evaluates expression and returns its value. */
 BtorBitVector *btor_eval_exp (Btor *btor, BtorNode *exp);
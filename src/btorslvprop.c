@@ -10,6 +10,7 @@
 
 #include "btorabort.h"
 #include "btorbv.h"
+#include "btorbvprop.h"
 #include "btorclone.h"
 #include "btorcore.h"
 #include "btordbg.h"
@@ -36,6 +37,18 @@
 
 #define BTOR_PROP_SELECT_CFACT 20
 
+/* probabilities adapted by the adaptive controller (BTOR_OPT_LS_ADAPTIVE),
+ * BTOR_OPT_PROP_PROB_FLIP_COND_CONST is already adapted on the fly */
+static const BtorOption prop_adaptive_opts[] = {
+    BTOR_OPT_PROP_PROB_USE_INV_VALUE,
+    BTOR_OPT_PROP_PROB_FLIP_COND,
+    BTOR_OPT_PROP_PROB_SLICE_KEEP_DC,
+    BTOR_OPT_PROP_PROB_CONC_FLIP,
+    BTOR_OPT_PROP_PROB_SLICE_FLIP,
+    BTOR_OPT_PROP_PROB_EQ_FLIP,
+    BTOR_OPT_PROP_PROB_AND_FLIP,
+};
+
 /*------------------------------------------------------------------------*/
 
 static BtorNode *
@@ -172,7 +185,9 @@ move (Btor *btor, uint32_t nmoves)
       slv->roots,
       btor_opt_get (btor, BTOR_OPT_PROP_USE_BANDIT) ? slv->score : 0,
       exps,
+      slv->cones,
       true,
+      0,
       &slv->stats.updates,
       &slv->time.update_cone,
       &slv->time.update_cone_reset,
@@ -206,6 +221,8 @@ clone_prop_solver (Btor *clone, BtorPropSolver *slv, BtorNodeMap *exp_map)
   res->roots = btor_hashint_map_clone (clone->mm, slv->roots, 0, 0);
   res->score =
       btor_hashint_map_clone (clone->mm, slv->score, btor_clone_data_as_dbl, 0);
+  res->cones   = 0;
+  res->domains = 0;
 
   return res;
 }
@@ -220,6 +237,8 @@ delete_prop_solver (BtorPropSolver *slv)
 
   if (slv->score) btor_hashint_map_delete (slv->score);
   if (slv->roots) btor_hashint_map_delete (slv->roots);
+  if (slv->cones) btor_lsutils_delete_cones (slv->cones);
+  if (slv->domains) btor_bvprop_delete_domains (slv->btor, slv->domains);
 
   BTOR_DELETE (slv->btor->mm, slv);
 }
@@ -238,15 +257,19 @@ sat_prop_solver_aux (Btor *btor)
   uint32_t j, max_steps;
   int32_t sat_result;
   uint32_t nmoves, nprops;
+  double start;
   BtorNode *root;
   BtorPtrHashTableIterator it;
   BtorPropSolver *slv;
+  BtorLsController *ctrl;
 
-  slv = BTOR_PROP_SOLVER (btor);
+  start = btor_util_time_stamp ();
+  slv   = BTOR_PROP_SOLVER (btor);
   assert (slv);
   nprops = btor_opt_get (btor, BTOR_OPT_PROP_NPROPS);
 
   nmoves = 0;
+  ctrl   = 0;
 
   /* check for constraints occurring in both phases */
   btor_iter_hashptr_init (&it, btor->assumptions);
@@ -263,6 +286,25 @@ sat_prop_solver_aux (Btor *btor)
       goto UNSAT;
   }
 
+  assert (!slv->cones);
+  slv->cones = btor_lsutils_new_cones (btor);
+
+  assert (!slv->domains);
+  if (btor_opt_get (btor, BTOR_OPT_PROP_DOMAINS))
+    slv->domains = btor_bvprop_compute_domains (
+        btor, BTOR_PROPUTILS_DOMAINS_MAX_ROUNDS);
+
+  if (btor_opt_get (btor, BTOR_OPT_LS_ADAPTIVE))
+    ctrl = btor_lsutils_new_controller (
+        btor,
+        prop_adaptive_opts,
+        sizeof (prop_adaptive_opts) / sizeof (*prop_adaptive_opts),
+        btor->unsynthesized_constraints->count
+            + btor->synthesized_constraints->count + btor->assumptions->count,
+        btor_opt_get (btor, BTOR_OPT_PROP_USE_RESTARTS),
+        &slv->stats.noise_inc,
+        &slv->stats.noise_dec);
+
   for (;;)
   {
     /* collect unsatisfied roots (kept up-to-date in update_cone) */
@@ -309,9 +351,12 @@ sat_prop_solver_aux (Btor *btor)
             ? -BTOR_PROPUTILS_PROB_FLIP_COND_CONST_DELTA
             : BTOR_PROPUTILS_PROB_FLIP_COND_CONST_DELTA;
 
-    /* move */
+    if (ctrl) btor_lsutils_controller_start (ctrl, slv->roots->count);
+
+    /* move (the restart schedule is determined by 'ctrl' if enabled) */
     for (j = 0, max_steps = BTOR_PROP_MAXSTEPS (slv->stats.restarts + 1);
-         !btor_opt_get (btor, BTOR_OPT_PROP_USE_RESTARTS) || j < max_steps;
+         ctrl || !btor_opt_get (btor, BTOR_OPT_PROP_USE_RESTARTS)
+         || j < max_steps;
          j++)
     {
       if (btor_terminate (btor) || (nprops && slv->stats.props >= nprops))
@@ -325,6 +370,9 @@ sat_prop_solver_aux (Btor *btor)
 
       /* all constraints sat? */
       if (!slv->roots->count) goto SAT;
+
+      if (ctrl && btor_lsutils_controller_move (ctrl, slv->roots->count))
+        break;
     }
 
     /* restart */
@@ -357,9 +405,45 @@ DONE:
     btor_hashint_map_delete (slv->score);
     slv->score = 0;
   }
+  if (slv->cones)
+  {
+    btor_lsutils_delete_cones (slv->cones);
+    slv->cones = 0;
+  }
+  if (slv->domains)
+  {
+    btor_bvprop_delete_domains (btor, slv->domains);
+    slv->domains = 0;
+  }
+  if (ctrl)
+  {
+    btor_lsutils_print_controller_trace (ctrl);
+    btor_lsutils_delete_controller (ctrl);
+  }
+  slv->time.sat += btor_util_time_stamp () - start;
   return sat_result;
 }
 
+#ifdef BTOR_HAVE_PTHREADS
+static void
+add_worker_stats (BtorPropSolver *slv, BtorPropSolver *wslv)
+{
+  assert (wslv->kind == BTOR_PROP_SOLVER_KIND);
+
+  slv->stats.restarts += wslv->stats.restarts;
+  slv->stats.moves += wslv->stats.moves;
+  slv->stats.rec_conf += wslv->stats.rec_conf;
+  slv->stats.non_rec_conf += wslv->stats.non_rec_conf;
+  slv->stats.props += wslv->stats.props;
+  slv->stats.props_cons += wslv->stats.props_cons;
+  slv->stats.props_inv += wslv->stats.props_inv;
+  slv->stats.props_dom += wslv->stats.props_dom;
+  slv->stats.updates += wslv->stats.updates;
+  slv->stats.noise_inc += wslv->stats.noise_inc;
+  slv->stats.noise_dec += wslv->stats.noise_dec;
+}
+#endif
+
 /* Note: failed assumptions handling not necessary, prop only works for SAT */
 static int32_t
 sat_prop_solver (BtorPropSolver *slv)
@@ -386,10 +470,27 @@ sat_prop_solver (BtorPropSolver *slv)
                       && btor->lambdas->count != 0),
               "prop engine supports QF_BV only");
 
-  /* Generate intial model, all bv vars are initialized with zero. We do
-   * not have to consider model_for_all_nodes, but let this be handled by
-   * the model generation (if enabled) after SAT has been determined. */
-  slv->api.generate_model ((BtorSolver *) slv, false, true);
+#ifdef BTOR_HAVE_PTHREADS
+  if (btor_opt_get (btor, BTOR_OPT_LS_NTHREADS) > 1)
+  {
+    double start = btor_util_time_stamp ();
+    sat_result   = btor_lsutils_sat_portfolio (
+        btor,
+        (BtorSolver *) slv,
+        btor_opt_get (btor, BTOR_OPT_LS_NTHREADS),
+        btor_new_prop_solver,
+        (void (*) (BtorSolver *, BtorSolver *)) add_worker_stats);
+    slv->time.sat += btor_util_time_stamp () - start;
+    goto DONE;
+  }
+#endif
+
+  /* Generate intial model, all bv vars are initialized with zero (unless
+   * a model has been seeded, e.g., by the preprop/presls scheduler of the
+   * fun engine). We do not have to consider model_for_all_nodes, but let this
+   * be handled by the model generation (if enabled) after SAT has been
+   * determined. */
+  slv->api.generate_model ((BtorSolver *) slv, false, false);
   sat_result = sat_prop_solver_aux (btor);
 DONE:
   return sat_result;
@@ -427,10 +528,16 @@ print_stats_prop_solver (BtorPropSolver *slv)
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg, 1, "restarts: %u", slv->stats.restarts);
   BTOR_MSG (btor->msg, 1, "moves: %u", slv->stats.moves);
+  if (btor_opt_get (btor, BTOR_OPT_LS_ADAPTIVE))
+    BTOR_MSG (btor->msg,
+              1,
+              "adaptive noise increments/decrements: %u/%u",
+              slv->stats.noise_inc,
+              slv->stats.noise_dec);
   BTOR_MSG (btor->msg,
             1,
             "moves per second: %.2f",
-            (double) slv->stats.moves / (btor->time.sat - btor->time.simplify));
+            slv->time.sat > 0 ? (double) slv->stats.moves / slv->time.sat : 0);
   BTOR_MSG (btor->msg, 1, "propagation (steps): %u", slv->stats.props);
   BTOR_MSG (btor->msg,
             1,
@@ -438,10 +545,15 @@ print_stats_prop_solver (BtorPropSolver *slv)
             slv->stats.props_cons);
   BTOR_MSG (
       btor->msg, 1, "   inverse value propagations: %u", slv->stats.props_inv);
+  if (btor_opt_get (btor, BTOR_OPT_PROP_DOMAINS))
+    BTOR_MSG (btor->msg,
+              1,
+              "   propagated values adjusted to fixed bits: %u",
+              slv->stats.props_dom);
   BTOR_MSG (btor->msg,
             1,
             "propagation (steps) per second: %.2f",
-            (double) slv->stats.props / (btor->time.sat - btor->time.simplify));
+            slv->time.sat > 0 ? (double) slv->stats.props / slv->time.sat : 0);
   BTOR_MSG (btor->msg, 1, "updates (cone): %u", slv->stats.updates);
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg,
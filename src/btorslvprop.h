@@ -10,6 +10,7 @@
 #define BTORSLVPROP_H_INCLUDED
 
 #include "btorbv.h"
+#include "btorlsutils.h"
 #include "btorslv.h"
 #include "btortypes.h"
 #include "utils/btorhashint.h"
@@ -20,6 +21,8 @@ struct BtorPropSolver
 
   BtorIntHashTable *roots; /* map: maintains 'selected' */
   BtorIntHashTable *score;
+  BtorLsCones *cones;        /* fan-out cones of inputs, valid during sat */
+  BtorIntHashTable *domains; /* fixed-bit domains, valid during sat */
 
   /* current probability for selecting the cond when either the
    * 'then' or 'else' branch is const (path selection) */
@@ -40,7 +43,10 @@ struct BtorPropSolver
     uint64_t props;
     uint64_t props_cons;
     uint64_t props_inv;
+    uint64_t props_dom; /* propagated values adjusted to fixed bits */
     uint64_t updates;
+    uint32_t noise_inc; /* adaptive controller */
+    uint32_t noise_dec;
 
 #ifndef NDEBUG
     uint32_t inv_add;
@@ -73,6 +79,7 @@ struct BtorPropSolver
 
   struct
   {
+    double sat;
     double update_cone;
     double update_cone_reset;
     double update_cone_model_gen;
@@ -11,6 +11,7 @@
 
 #include "btorabort.h"
 #include "btorbv.h"
+#include "btorbvprop.h"
 #include "btorclone.h"
 #include "btorcore.h"
 #include "btordbg.h"
@@ -47,10 +48,24 @@
 /* start segments from MSB rather than LSB (prob=0.5) */
 #define BTOR_SLS_PROB_SEG_MSB_VS_LSB 500
 
+/* probabilities adapted by the adaptive controller (BTOR_OPT_LS_ADAPTIVE) */
+static const BtorOption sls_adaptive_opts[] = {
+    BTOR_OPT_SLS_PROB_MOVE_RAND_WALK,
+    BTOR_OPT_PROP_PROB_USE_INV_VALUE,
+    BTOR_OPT_PROP_PROB_FLIP_COND,
+    BTOR_OPT_PROP_PROB_SLICE_KEEP_DC,
+    BTOR_OPT_PROP_PROB_CONC_FLIP,
+    BTOR_OPT_PROP_PROB_SLICE_FLIP,
+    BTOR_OPT_PROP_PROB_EQ_FLIP,
+    BTOR_OPT_PROP_PROB_AND_FLIP,
+};
+
 /*------------------------------------------------------------------------*/
 
 static double
-compute_sls_score_formula (Btor *btor, BtorIntHashTable *score, bool *done)
+compute_sls_score_formula (Btor *btor,
+                           BtorIntHashTable *score,
+                           uint32_t *nunsat)
 {
   assert (btor);
   assert (score);
@@ -66,7 +81,7 @@ compute_sls_score_formula (Btor *btor, BtorIntHashTable *score, bool *done)
   assert (slv->weights);
 
   res = 0.0;
-  if (done) *done = true;
+  if (nunsat) *nunsat = 0;
 
   btor_iter_hashint_init (&it, slv->weights);
   while (btor_iter_hashint_has_next (&it))
@@ -77,7 +92,7 @@ compute_sls_score_formula (Btor *btor, BtorIntHashTable *score, bool *done)
     id = btor_iter_hashint_next (&it);
     sc = btor_hashint_map_get (score, id)->as_dbl;
     assert (sc >= 0.0 && sc <= 1.0);
-    if (done && sc < 1.0) *done = false;
+    if (nunsat && sc < 1.0) *nunsat += 1;
     res += weight * sc;
   }
   return res;
@@ -294,20 +309,15 @@ update_assertion_weights (Btor *btor)
 }
 
 static inline double
-try_move (Btor *btor,
-          BtorIntHashTable *bv_model,
-          BtorIntHashTable *score,
-          BtorIntHashTable *cans,
-          bool *done)
+try_move (Btor *btor, BtorIntHashTable *cans, bool prune, bool *done)
 {
   assert (btor);
-  assert (bv_model);
-  assert (score);
   assert (cans);
   assert (cans->count);
   assert (done);
 
   BtorSLSSolver *slv;
+  BtorLsScoreDelta sd;
 
   slv = BTOR_SLS_SOLVER (btor);
   assert (slv);
@@ -345,19 +355,46 @@ try_move (Btor *btor,
   }
 #endif
 
+  /* the move is tried on the current model and scores and reverted
+   * afterwards, only the roots in the cone of the candidates are rescored,
+   * and we stop as soon as the move can not be selected anymore */
+  sd.weights = slv->weights;
+  sd.base    = slv->cur_score;
+  sd.nunsat  = slv->cur_nunsat;
+  sd.prune   = prune;
+  sd.ties    = btor_opt_get (btor, BTOR_OPT_SLS_STRATEGY)
+            == BTOR_SLS_STRAT_BEST_SAME_MOVE;
+  sd.bound = slv->max_score;
+
   btor_lsutils_update_cone (btor,
-                            bv_model,
+                            btor->bv_model,
                             slv->roots,
-                            score,
+                            slv->score,
                             cans,
+                            slv->cones,
                             false,
+                            &sd,
                             &slv->stats.updates,
                             &slv->time.update_cone,
                             &slv->time.update_cone_reset,
                             &slv->time.update_cone_model_gen,
                             &slv->time.update_cone_compute_score);
 
-  return compute_sls_score_formula (btor, score, done);
+  if (sd.pruned) slv->stats.pruned += 1;
+#ifndef NDEBUG
+  if (!sd.pruned)
+  {
+    uint32_t nunsat;
+    double sc = compute_sls_score_formula (btor, slv->score, &nunsat);
+    assert (fabs (sc - sd.res) <= 1e-9 * (sc > 1.0 ? sc : 1.0));
+    assert ((nunsat == 0) == sd.done);
+  }
+#endif
+  btor_lsutils_undo_update_cone (
+      btor, btor->bv_model, slv->score, slv->cones);
+
+  *done = sd.done;
+  return sd.res;
 }
 
 static int32_t
@@ -438,7 +475,7 @@ select_inc_dec_not_move (Btor *btor,
   BtorSLSMoveKind mk;
   BtorBitVector *ass, *max_neigh;
   BtorNode *can;
-  BtorIntHashTable *cans, *bv_model, *score;
+  BtorIntHashTable *cans;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
 
@@ -456,10 +493,6 @@ select_inc_dec_not_move (Btor *btor,
     mk = BTOR_SLS_MOVE_NOT;
   }
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
-
   cans = btor_hashint_map_new (btor->mm);
 
   for (i = 0; i < BTOR_COUNT_STACK (*candidates); i++)
@@ -481,7 +514,7 @@ select_inc_dec_not_move (Btor *btor,
             : fun (btor->mm, ass);
   }
 
-  sc = try_move (btor, bv_model, score, cans, &done);
+  sc = try_move (btor, cans, sls_strat != BTOR_SLS_STRAT_RAND_WALK, &done);
   if (slv->terminate)
   {
     BTOR_SLS_DELETE_CANS (cans);
@@ -490,8 +523,6 @@ select_inc_dec_not_move (Btor *btor,
   BTOR_SLS_SELECT_MOVE_CHECK_SCORE (sc);
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
   return done;
 }
 
@@ -506,7 +537,7 @@ select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   BtorSLSMoveKind mk;
   BtorBitVector *ass, *max_neigh;
   BtorNode *can;
-  BtorIntHashTable *cans, *bv_model, *score;
+  BtorIntHashTable *cans;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
 
@@ -515,10 +546,6 @@ select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_FLIP;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
-
   for (pos = 0, n_endpos = 0; n_endpos < BTOR_COUNT_STACK (*candidates); pos++)
   {
     cans = btor_hashint_map_new (btor->mm);
@@ -545,7 +572,7 @@ select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
               : btor_bv_flipped_bit (btor->mm, ass, cpos);
     }
 
-    sc = try_move (btor, bv_model, score, cans, &done);
+    sc = try_move (btor, cans, sls_strat != BTOR_SLS_STRAT_RAND_WALK, &done);
     if (slv->terminate)
     {
       BTOR_SLS_DELETE_CANS (cans);
@@ -555,8 +582,6 @@ select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
   return done;
 }
 
@@ -571,7 +596,7 @@ select_flip_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   BtorSLSMoveKind mk;
   BtorBitVector *ass, *max_neigh;
   BtorNode *can;
-  BtorIntHashTable *cans, *bv_model, *score;
+  BtorIntHashTable *cans;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
 
@@ -580,10 +605,6 @@ select_flip_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_FLIP_RANGE;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
-
   for (up = 1, n_endpos = 0; n_endpos < BTOR_COUNT_STACK (*candidates);
        up = 2 * up + 1)
   {
@@ -625,7 +646,7 @@ select_flip_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
               : btor_bv_flipped_bit_range (btor->mm, ass, cup, clo);
     }
 
-    sc = try_move (btor, bv_model, score, cans, &done);
+    sc = try_move (btor, cans, sls_strat != BTOR_SLS_STRAT_RAND_WALK, &done);
     if (slv->terminate)
     {
       BTOR_SLS_DELETE_CANS (cans);
@@ -635,8 +656,6 @@ select_flip_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
   return done;
 }
 
@@ -652,7 +671,7 @@ select_flip_segment_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   BtorSLSMoveKind mk;
   BtorBitVector *ass, *max_neigh;
   BtorNode *can;
-  BtorIntHashTable *cans, *bv_model, *score;
+  BtorIntHashTable *cans;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
 
@@ -661,10 +680,6 @@ select_flip_segment_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_FLIP_SEGMENT;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
-
   for (seg = 2; seg <= 8; seg <<= 1)
   {
     for (lo = 0, up = seg - 1, n_endpos = 0;
@@ -712,7 +727,7 @@ select_flip_segment_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
                 : btor_bv_flipped_bit_range (btor->mm, ass, cup, clo);
       }
 
-      sc = try_move (btor, bv_model, score, cans, &done);
+      sc = try_move (btor, cans, sls_strat != BTOR_SLS_STRAT_RAND_WALK, &done);
       if (slv->terminate)
       {
         BTOR_SLS_DELETE_CANS (cans);
@@ -723,8 +738,6 @@ select_flip_segment_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
   return done;
 }
 
@@ -739,7 +752,7 @@ select_rand_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   BtorSLSMoveKind mk;
   BtorBitVector *ass;
   BtorNode *can;
-  BtorIntHashTable *cans, *bv_model, *score;
+  BtorIntHashTable *cans;
   BtorIntHashTableIterator iit;
   BtorSLSSolver *slv;
 
@@ -749,10 +762,6 @@ select_rand_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_RAND;
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
-
   for (up = 1, n_endpos = 0; n_endpos < BTOR_COUNT_STACK (*candidates);
        up = 2 * up + 1)
   {
@@ -786,7 +795,7 @@ select_rand_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
           btor_bv_new_random_bit_range (btor->mm, &btor->rng, bw, cup, clo);
     }
 
-    sc = try_move (btor, bv_model, score, cans, &done);
+    sc = try_move (btor, cans, false, &done);
     if (slv->terminate)
     {
       BTOR_SLS_DELETE_CANS (cans);
@@ -802,8 +811,6 @@ select_rand_range_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
   }
 
 DONE:
-  btor_model_delete_bv (btor, &bv_model);
-  btor_hashint_map_delete (score);
   return done;
 }
 
@@ -1204,7 +1211,9 @@ move (Btor *btor, uint32_t nmoves)
       goto DONE;
     }
 
-    slv->max_score = compute_sls_score_formula (btor, slv->score, 0);
+    slv->cur_score =
+        compute_sls_score_formula (btor, slv->score, &slv->cur_nunsat);
+    slv->max_score = slv->cur_score;
     slv->max_move  = BTOR_SLS_MOVE_DONE;
     slv->max_gw    = -1;
 
@@ -1260,7 +1269,9 @@ move (Btor *btor, uint32_t nmoves)
                             slv->roots,
                             slv->score,
                             slv->max_cans,
+                            slv->cones,
                             true,
+                            0,
                             &slv->stats.updates,
                             &slv->time.update_cone,
                             &slv->time.update_cone_reset,
@@ -1408,6 +1419,8 @@ clone_sls_solver (Btor *clone, BtorSLSSolver *slv, BtorNodeMap *exp_map)
 
   res->max_cans = btor_hashint_map_clone (
       clone->mm, slv->max_cans, btor_clone_data_as_bv_ptr, 0);
+  res->cones   = 0;
+  res->domains = 0;
 
   return res;
 }
@@ -1429,6 +1442,8 @@ delete_sls_solver (BtorSLSSolver *slv)
 
   if (slv->score) btor_hashint_map_delete (slv->score);
   if (slv->roots) btor_hashint_map_delete (slv->roots);
+  if (slv->cones) btor_lsutils_delete_cones (slv->cones);
+  if (slv->domains) btor_bvprop_delete_domains (slv->btor, slv->domains);
   if (slv->weights)
   {
     btor_iter_hashint_init (&it, slv->weights);
@@ -1461,6 +1476,42 @@ delete_sls_solver (BtorSLSSolver *slv)
   BTOR_DELETE (btor->mm, slv);
 }
 
+#ifdef BTOR_HAVE_PTHREADS
+static void
+add_worker_stats (BtorSLSSolver *slv, BtorSLSSolver *wslv)
+{
+  assert (wslv->kind == BTOR_SLS_SOLVER_KIND);
+
+  slv->stats.restarts += wslv->stats.restarts;
+  slv->stats.moves += wslv->stats.moves;
+  slv->stats.flips += wslv->stats.flips;
+  slv->stats.props += wslv->stats.props;
+  slv->stats.move_flip += wslv->stats.move_flip;
+  slv->stats.move_inc += wslv->stats.move_inc;
+  slv->stats.move_dec += wslv->stats.move_dec;
+  slv->stats.move_not += wslv->stats.move_not;
+  slv->stats.move_range += wslv->stats.move_range;
+  slv->stats.move_seg += wslv->stats.move_seg;
+  slv->stats.move_rand += wslv->stats.move_rand;
+  slv->stats.move_rand_walk += wslv->stats.move_rand_walk;
+  slv->stats.move_prop += wslv->stats.move_prop;
+  slv->stats.move_prop_rec_conf += wslv->stats.move_prop_rec_conf;
+  slv->stats.move_prop_non_rec_conf += wslv->stats.move_prop_non_rec_conf;
+  slv->stats.move_gw_flip += wslv->stats.move_gw_flip;
+  slv->stats.move_gw_inc += wslv->stats.move_gw_inc;
+  slv->stats.move_gw_dec += wslv->stats.move_gw_dec;
+  slv->stats.move_gw_not += wslv->stats.move_gw_not;
+  slv->stats.move_gw_range += wslv->stats.move_gw_range;
+  slv->stats.move_gw_seg += wslv->stats.move_gw_seg;
+  slv->stats.move_gw_rand += wslv->stats.move_gw_rand;
+  slv->stats.move_gw_rand_walk += wslv->stats.move_gw_rand_walk;
+  slv->stats.pruned += wslv->stats.pruned;
+  slv->stats.updates += wslv->stats.updates;
+  slv->stats.noise_inc += wslv->stats.noise_inc;
+  slv->stats.noise_dec += wslv->stats.noise_dec;
+}
+#endif
+
 /* Note: failed assumptions -> no handling necessary, sls only works for SAT
  * Note: limits are currently unused */
 static BtorSolverResult
@@ -1479,9 +1530,11 @@ sat_sls_solver (BtorSLSSolver *slv)
   BtorPtrHashTableIterator pit;
   BtorIntHashTableIterator iit;
   Btor *btor;
+  BtorLsController *ctrl;
 
   btor = slv->btor;
   assert (!btor->inconsistent);
+  ctrl        = 0;
   nmoves      = 0;
   nprops      = btor_opt_get (btor, BTOR_OPT_PROP_NPROPS);
   slv->nflips = btor_opt_get (btor, BTOR_OPT_SLS_NFLIPS);
@@ -1497,10 +1550,25 @@ sat_sls_solver (BtorSLSSolver *slv)
                       && btor->lambdas->count != 0),
               "sls engine supports QF_BV only");
 
-  /* Generate intial model, all bv vars are initialized with zero. We do
-   * not have to consider model_for_all_nodes, but let this be handled by
-   * the model generation (if enabled) after SAT has been determined. */
-  slv->api.generate_model ((BtorSolver *) slv, false, true);
+#ifdef BTOR_HAVE_PTHREADS
+  if (btor_opt_get (btor, BTOR_OPT_LS_NTHREADS) > 1)
+  {
+    sat_result = btor_lsutils_sat_portfolio (
+        btor,
+        (BtorSolver *) slv,
+        btor_opt_get (btor, BTOR_OPT_LS_NTHREADS),
+        btor_new_sls_solver,
+        (void (*) (BtorSolver *, BtorSolver *)) add_worker_stats);
+    goto DONE;
+  }
+#endif
+
+  /* Generate intial model, all bv vars are initialized with zero (unless
+   * a model has been seeded, e.g., by the preprop/presls scheduler of the
+   * fun engine). We do not have to consider model_for_all_nodes, but let this
+   * be handled by the model generation (if enabled) after SAT has been
+   * determined. */
+  slv->api.generate_model ((BtorSolver *) slv, false, false);
 
   /* init assertion weights of ALL roots */
   assert (!slv->weights);
@@ -1540,6 +1608,24 @@ sat_sls_solver (BtorSLSSolver *slv)
 
   if (!slv->score) slv->score = btor_hashint_map_new (btor->mm);
 
+  assert (!slv->cones);
+  slv->cones = btor_lsutils_new_cones (btor);
+
+  assert (!slv->domains);
+  if (btor_opt_get (btor, BTOR_OPT_PROP_DOMAINS))
+    slv->domains = btor_bvprop_compute_domains (
+        btor, BTOR_PROPUTILS_DOMAINS_MAX_ROUNDS);
+
+  if (btor_opt_get (btor, BTOR_OPT_LS_ADAPTIVE))
+    ctrl = btor_lsutils_new_controller (
+        btor,
+        sls_adaptive_opts,
+        sizeof (sls_adaptive_opts) / sizeof (*sls_adaptive_opts),
+        btor->unsynthesized_constraints->count + btor->assumptions->count,
+        btor_opt_get (btor, BTOR_OPT_SLS_USE_RESTARTS),
+        &slv->stats.noise_inc,
+        &slv->stats.noise_dec);
+
   for (;;)
   {
     if (btor_terminate (btor))
@@ -1580,8 +1666,12 @@ sat_sls_solver (BtorSLSSolver *slv)
 
     if (!slv->roots->count) goto SAT;
 
+    if (ctrl) btor_lsutils_controller_start (ctrl, slv->roots->count);
+
+    /* the restart schedule is determined by 'ctrl' if enabled */
     for (j = 0, max_steps = BTOR_SLS_MAXSTEPS (slv->stats.restarts + 1);
-         !btor_opt_get (btor, BTOR_OPT_SLS_USE_RESTARTS) || j < max_steps;
+         ctrl || !btor_opt_get (btor, BTOR_OPT_SLS_USE_RESTARTS)
+         || j < max_steps;
          j++)
     {
       if (btor_terminate (btor)
@@ -1596,6 +1686,9 @@ sat_sls_solver (BtorSLSSolver *slv)
       nmoves += 1;
 
       if (!slv->roots->count) goto SAT;
+
+      if (ctrl && btor_lsutils_controller_move (ctrl, slv->roots->count))
+        break;
     }
 
     /* restart */
@@ -1635,6 +1728,21 @@ DONE:
     btor_hashint_map_delete (slv->score);
     slv->score = 0;
   }
+  if (slv->cones)
+  {
+    btor_lsutils_delete_cones (slv->cones);
+    slv->cones = 0;
+  }
+  if (slv->domains)
+  {
+    btor_bvprop_delete_domains (btor, slv->domains);
+    slv->domains = 0;
+  }
+  if (ctrl)
+  {
+    btor_lsutils_print_controller_trace (ctrl);
+    btor_lsutils_delete_controller (ctrl);
+  }
   return sat_result;
 }
 
@@ -1674,7 +1782,14 @@ print_stats_sls_solver (BtorSLSSolver *slv)
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg, 1, "sls restarts: %d", slv->stats.restarts);
   BTOR_MSG (btor->msg, 1, "sls moves: %d", slv->stats.moves);
+  if (btor_opt_get (btor, BTOR_OPT_LS_ADAPTIVE))
+    BTOR_MSG (btor->msg,
+              1,
+              "sls adaptive noise increments/decrements: %u/%u",
+              slv->stats.noise_inc,
+              slv->stats.noise_dec);
   BTOR_MSG (btor->msg, 1, "sls flips: %d", slv->stats.flips);
+  BTOR_MSG (btor->msg, 1, "sls pruned flips: %u", slv->stats.pruned);
   BTOR_MSG (btor->msg, 1, "sls propagation steps: %u", slv->stats.props);
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg,
@@ -14,6 +14,7 @@
 #include "btorbv.h"
 #endif
 
+#include "btorlsutils.h"
 #include "btorslv.h"
 #include "utils/btorhashint.h"
 #include "utils/btorstack.h"
@@ -61,6 +62,8 @@ struct BtorSLSSolver
                                 but does not maintain anything */
   BtorIntHashTable *weights; /* also maintains assertion weights */
   BtorIntHashTable *score;   /* sls score */
+  BtorLsCones *cones;        /* fan-out cones of inputs, valid during sat */
+  BtorIntHashTable *domains; /* fixed-bit domains, valid during sat */
 
   uint32_t nflips; /* limit, disabled if 0 */
   bool terminate;
@@ -80,6 +83,8 @@ struct BtorSLSSolver
    * randomized move). */
   BtorIntHashTable *max_cans; /* list of (can, neigh) */
   double max_score;
+  double cur_score;    /* score of the formula before the move */
+  uint32_t cur_nunsat; /* number of unsatisfied roots before the move */
   BtorSLSMoveKind max_move; /* move kind (for stats) */
   int32_t max_gw;           /* is groupwise move? (for stats) */
 
@@ -89,6 +94,7 @@ struct BtorSLSSolver
     uint32_t restarts;
     uint32_t moves;
     uint32_t flips;
+    uint32_t pruned; /* tried flips aborted early (score bound) */
     uint32_t props;
     uint32_t move_flip;
     uint32_t move_inc;
@@ -110,6 +116,8 @@ struct BtorSLSSolver
     uint32_t move_gw_rand;
     uint32_t move_gw_rand_walk;
     uint64_t updates;
+    uint32_t noise_inc; /* adaptive controller */
+    uint32_t noise_dec;
   } stats;
 
   struct
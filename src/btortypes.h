@@ -75,6 +75,17 @@ enum BtorOption
   */
   BTOR_OPT_INCREMENTAL_SMT1,
 
+  /*!
+    * **BTOR_OPT_INCREMENTAL_PHASES**
+
+      | Enable (``value``: 1) or disable (``value``: 0) passing the model of
+        the previous call to boolector_sat as phase hints to the SAT solver.
+      | Requires incremental usage and model generation (see
+        BTOR_OPT_INCREMENTAL and BTOR_OPT_MODEL_GEN). Phase hints set via
+        boolector_set_phase_hint take precedence.
+  */
+  BTOR_OPT_INCREMENTAL_PHASES,
+
   /*!
     * **BTOR_OPT_INPUT_FORMAT**
 
@@ -340,6 +351,29 @@ enum BtorOption
    */
   BTOR_OPT_FUN_PRESLS,
 
+  /*!
+    * **BTOR_OPT_FUN_PRESCHED**
+
+      Enable (``value``: 1) or disable (``value``: 0) interleaving the
+      preprocessing engine (see BTOR_OPT_FUN_PREPROP and BTOR_OPT_FUN_PRESLS)
+      and the SAT solver in time slices of increasing size instead of running
+      the preprocessing engine only once.
+   */
+  BTOR_OPT_FUN_PRESCHED,
+
+  /*!
+    * **BTOR_OPT_FUN_PREHYBRID**
+
+      Enable (``value``: 1) or disable (``value``: 0) the hybrid scheduler
+      for the preprocessing engine (see BTOR_OPT_FUN_PREPROP and
+      BTOR_OPT_FUN_PRESLS). Roots that remain unsatisfied over consecutive
+      local search slices are bit-blasted and checked by the SAT solver,
+      with all inputs they share with the remaining roots fixed to the
+      current assignment via assumptions. Takes precedence over
+      BTOR_OPT_FUN_PRESCHED.
+   */
+  BTOR_OPT_FUN_PREHYBRID,
+
   /*!
     * **BTOR_OPT_FUN_DUAL_PROP**
 
@@ -428,6 +462,27 @@ enum BtorOption
    */
   /* --------------------------------------------------------------------- */
 
+  /*!
+    * **BTOR_OPT_LS_NTHREADS**
+
+      Set the number of threads used by the sls and prop engines. If greater
+      than 1, the engine runs the given number of workers with different
+      seeds on clones of the formula, the first worker that determines a
+      result wins. Ignored if Boolector was built without pthreads.
+   */
+  BTOR_OPT_LS_NTHREADS,
+
+  /*!
+    * **BTOR_OPT_LS_ADAPTIVE**
+
+      Enable (``value``: 1) or disable (``value``: 0) the adaptive strategy
+      controller of the local search engines (prop, sls and aigprop). The
+      controller monitors the number of unsatisfied roots and adapts the
+      probability options of the engine (noise) and the restart interval
+      online. The adaptation trace is printed with verbosity level 2.
+   */
+  BTOR_OPT_LS_ADAPTIVE,
+
   /*!
     * **BTOR_OPT_SLS_NFIPS**
       Set the number of bit flips used as a limit for the sls engine. Disabled
@@ -744,6 +799,27 @@ enum BtorOption
     */
   BTOR_OPT_PROP_NO_MOVE_ON_CONFLICT,
 
+  /*!
+    * **BTOR_OPT_PROP_NSAMPLES**
+
+      | Number of inverse values sampled per propagation step.
+      | If greater than 1, for operations of bit-width <= 64 (add, and, eq,
+        ult, mul), the sampled inverse value closest (in terms of Hamming
+        distance) to the current assignment of the selected node is chosen.
+    */
+  BTOR_OPT_PROP_NSAMPLES,
+
+  /*!
+    * **BTOR_OPT_PROP_DOMAINS**
+
+      | Enable (``value``: 1) or disable (``value``: 0) fixed-bit domains.
+      | If enabled, bits of nodes that are fixed by the constraints (e.g.,
+        by masks or slices of constants) are determined via constant bit
+        propagation prior to local search, and values propagated down during
+        a propagation move are adjusted to respect these fixed bits.
+    */
+  BTOR_OPT_PROP_DOMAINS,
+
   /* --------------------------------------------------------------------- */
   /*!
     **AIGProp Engine Options**:
@@ -768,6 +844,16 @@ enum BtorOption
   */
   BTOR_OPT_AIGPROP_USE_BANDIT,
 
+  /*!
+    * **BTOR_OPT_AIGPROP_NSAMPLES**
+
+      | Number of propagation moves sampled per move (max. 64).
+      | If greater than 1, all sampled moves are evaluated at once via
+        bit-parallel simulation of the cones of their inputs, and the move
+        that satisfies the most root constraints is performed.
+  */
+  BTOR_OPT_AIGPROP_NSAMPLES,
+
   /* QUANT engine ------------------------------------------------------- */
   /*!
     * **BTOR_OPT_QUANT_SYNTH**
@@ -857,6 +943,10 @@ enum BtorOption
   BTOR_OPT_QUANT_FIXSYNTH,
   BTOR_OPT_RW_ZERO_LOWER_SLICE,
   BTOR_OPT_NONDESTR_SUBST,
+  BTOR_OPT_FLATTEN_STORES,
+  BTOR_OPT_SIMP_BV_DOMAINS,
+  BTOR_OPT_SIMP_BV_WIDTHS,
+  BTOR_OPT_PP_PIPELINE,
   /* this MUST be the last entry! */
   BTOR_OPT_NUM_OPTS,
 };
@@ -750,6 +750,11 @@ NEXT:
       PARSE_ARGS0 (tok);
       boolector_reset_assumptions (btor);
     }
+    else if (!strcmp (tok, "set_phase_hint"))
+    {
+      PARSE_ARGS2 (tok, str, str);
+      boolector_set_phase_hint (btor, hmap_get (hmap, arg1_str), arg2_str);
+    }
     else if (!strcmp (tok, "fixate_assumptions"))
     {
       PARSE_ARGS0 (tok);
@@ -784,6 +789,11 @@ NEXT:
       PARSE_ARGS1 (tok, str);
       boolector_set_sat_solver (btor, arg1_str);
     }
+    else if (!strcmp (tok, "set_pp_pipeline"))
+    {
+      PARSE_ARGS1 (tok, str);
+      boolector_set_pp_pipeline (btor, arg1_str);
+    }
     else if (!strcmp (tok, "set_opt"))
     {
       opt = parse_opt (&arg1_str);
@@ -1978,6 +1988,11 @@ NEXT:
         BTOR_DELETEN (g_btorunt->mm, outfilename, flen);
       }
     }
+    else if (!strcmp (tok, "dump_lemmas_smt2"))
+    {
+      PARSE_ARGS0 (tok);
+      if (g_btorunt->dump_stdout) boolector_dump_lemmas_smt2 (btor, stdout);
+    }
     else if (!strcmp (tok, "dump_aiger_ascii"))
     {
       PARSE_ARGS1 (tok, int);
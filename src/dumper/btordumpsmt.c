@@ -12,6 +12,7 @@
 #include "btorcore.h"
 #include "btorexit.h"
 #include "btorexp.h"
+#include "btorslvfun.h"
 #include "btorsort.h"
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
@@ -1806,6 +1807,72 @@ btor_dumpsmt_dump (Btor *btor, FILE *file)
   dump_smt_aux (btor, file, 0, 0);
 }
 
+/* Check whether all inputs in the cone of 'exp' have a symbol, i.e., can be
+ * bound to the corresponding inputs when the dump is parsed again. */
+static bool
+has_named_inputs (Btor *btor, BtorNode *exp)
+{
+  bool res;
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *cache;
+
+  res = true;
+  BTOR_INIT_STACK (btor->mm, visit);
+  cache = btor_hashint_table_new (btor->mm);
+  BTOR_PUSH_STACK (visit, exp);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    if ((btor_node_is_bv_var (cur) || btor_node_is_uf (cur))
+        && !btor_node_get_symbol (btor, cur))
+    {
+      res = false;
+      break;
+    }
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  btor_hashint_table_delete (cache);
+  BTOR_RELEASE_STACK (visit);
+  return res;
+}
+
+void
+btor_dumpsmt_dump_lemmas (Btor *btor, FILE *file)
+{
+  assert (btor);
+  assert (file);
+
+  size_t i, j;
+  BtorNode *tmp;
+  BtorNodePtrStack lemmas;
+
+  BTOR_INIT_STACK (btor->mm, lemmas);
+  btor_fun_solver_get_lemmas (btor, &lemmas);
+  /* lemmas over unnamed inputs (e.g., fresh variables introduced by the
+   * solver) would only talk about fresh inputs after parsing */
+  for (i = 0, j = 0; i < BTOR_COUNT_STACK (lemmas); i++)
+  {
+    tmp = BTOR_PEEK_STACK (lemmas, i);
+    if (!has_named_inputs (btor, tmp)) continue;
+    BTOR_POKE_STACK (lemmas, j, tmp);
+    j += 1;
+  }
+  lemmas.top = lemmas.start + j;
+  if (BTOR_EMPTY_STACK (lemmas))
+  {
+    tmp = btor_exp_true (btor);
+    dump_smt_aux (btor, file, &tmp, 1);
+    btor_node_release (btor, tmp);
+  }
+  else
+    dump_smt_aux (btor, file, lemmas.start, BTOR_COUNT_STACK (lemmas));
+  BTOR_RELEASE_STACK (lemmas);
+}
+
 void
 btor_dumpsmt_dump_node (Btor *btor, FILE *file, BtorNode *exp, uint32_t depth)
 {
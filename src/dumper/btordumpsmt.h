@@ -23,6 +23,9 @@ void btor_dumpsmt_dump_node (Btor* btor,
 
 void btor_dumpsmt_dump (Btor* btor, FILE* file);
 
+/* Dump the lemmas generated by the fun solver as assertions. */
+void btor_dumpsmt_dump_lemmas (Btor* btor, FILE* file);
+
 void btor_dumpsmt_dump_const_value (Btor* btor,
                                     const BtorBitVector* bits,
                                     uint32_t base,
@@ -386,6 +386,9 @@ typedef struct BtorSMT2Parser
   /* SMT2 options */
   bool print_success;
   bool global_declarations;
+
+  /* bind declared symbols to existing nodes (parsing lemmas) */
+  bool bind_symbols;
 } BtorSMT2Parser;
 
 static int32_t
@@ -1025,6 +1028,15 @@ new_smt2_parser (Btor *btor)
   return res;
 }
 
+static BtorSMT2Parser *
+new_smt2_lemma_parser (Btor *btor)
+{
+  BtorSMT2Parser *res;
+  res               = new_smt2_parser (btor);
+  res->bind_symbols = true;
+  return res;
+}
+
 static void
 release_work_smt2 (BtorSMT2Parser *parser)
 {
@@ -3901,6 +3913,61 @@ parse_sort (BtorSMT2Parser *parser,
       parser, "expected '(' or 'Bool' at '%s'", parser->token.start);
 }
 
+/* Bind declared symbol 'fun' to the node with the same symbol and sort in
+ * the current Boolector instance. If no such node exists, 'fun' is bound to a
+ * fresh input without symbol, which is sound since lemmas are valid for any
+ * instantiation of their inputs. */
+static void
+bind_symbol_smt2 (BtorSMT2Parser *parser,
+                  BtorSMT2Node *fun,
+                  BoolectorSortStack *args,
+                  BoolectorSort sort)
+{
+  BoolectorNode *exp;
+  BoolectorSort s;
+  Btor *btor;
+
+  btor = parser->btor;
+  if (BTOR_EMPTY_STACK (*args))
+    s = sort;
+  else
+    s = boolector_fun_sort (btor, args->start, BTOR_COUNT_STACK (*args), sort);
+
+  exp = 0;
+  if (btor_node_get_by_symbol (btor, fun->name))
+  {
+    exp = boolector_match_node_by_symbol (btor, fun->name);
+    if (boolector_get_sort (btor, exp) != s)
+    {
+      boolector_release (btor, exp);
+      exp = 0;
+    }
+  }
+
+  if (exp)
+    BTOR_MSG (boolector_get_btor_msg (btor),
+              2,
+              "bound '%s' at line %d column %d",
+              fun->name,
+              fun->coo.x,
+              fun->coo.y);
+  else if (!BTOR_EMPTY_STACK (*args))
+  {
+    exp                    = boolector_uf (btor, s, 0);
+    parser->need_functions = true;
+  }
+  else if (boolector_is_fun_sort (btor, s))
+  {
+    exp                 = boolector_array (btor, s, 0);
+    parser->need_arrays = true;
+  }
+  else
+    exp = boolector_var (btor, s, 0);
+
+  if (!BTOR_EMPTY_STACK (*args)) boolector_release_sort (btor, s);
+  fun->exp = exp;
+}
+
 static int32_t
 declare_fun_smt2 (BtorSMT2Parser *parser, bool isconst)
 {
@@ -3963,6 +4030,12 @@ declare_fun_smt2 (BtorSMT2Parser *parser, bool isconst)
     BTOR_RELEASE_STACK (args);
     return 0;
   }
+  if (parser->bind_symbols)
+  {
+    bind_symbol_smt2 (parser, fun, &args, sort);
+    BTOR_RELEASE_STACK (args);
+    return read_rpar_smt2 (parser, " to close declaration");
+  }
   /* bit-vector/array variable */
   if (BTOR_EMPTY_STACK (args))
   {
@@ -4098,7 +4171,8 @@ define_fun_smt2 (BtorSMT2Parser *parser)
       len = strlen (fun->name) + strlen (arg->name) + 3;
       BTOR_CNEWN (parser->mem, psym, len);
       sprintf (psym, "_%s_%s", fun->name, arg->name);
-      arg->exp = boolector_param (parser->btor, s, psym);
+      arg->exp = boolector_param (
+          parser->btor, s, parser->bind_symbols ? 0 : psym);
       BTOR_DELETEN (parser->mem, psym, len);
       item       = push_item_smt2 (parser, arg->tag);
       item->node = arg;
@@ -4217,7 +4291,8 @@ define_fun_smt2 (BtorSMT2Parser *parser)
     else
     {
       fun->exp = tmp;
-      boolector_set_symbol (parser->btor, fun->exp, fun->name);
+      if (!parser->bind_symbols)
+        boolector_set_symbol (parser->btor, fun->exp, fun->name);
       parser->need_functions = true;
     }
     while (!BTOR_EMPTY_STACK (args))
@@ -4669,7 +4744,11 @@ read_command_smt2 (BtorSMT2Parser *parser)
 
     case BTOR_CHECK_SAT_TAG_SMT2:
       if (!read_rpar_smt2 (parser, " after 'check-sat'")) return 0;
-      check_sat (parser);
+      /* lemmas are only asserted, solving is up to the caller */
+      if (parser->bind_symbols)
+        parser->done = true;
+      else
+        check_sat (parser);
       break;
 
     case BTOR_CHECK_SAT_ASSUMING_TAG_SMT2:
@@ -5037,3 +5116,14 @@ btor_parsesmt2_parser_api ()
 {
   return &parsesmt2_parser_api;
 }
+
+static BtorParserAPI parsesmt2_lemma_parser_api = {
+    (BtorInitParser) new_smt2_lemma_parser,
+    (BtorResetParser) delete_smt2_parser,
+    (BtorParse) parse_smt2_parser};
+
+const BtorParserAPI *
+btor_parsesmt2_lemma_parser_api ()
+{
+  return &parsesmt2_lemma_parser_api;
+}
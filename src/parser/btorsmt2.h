@@ -17,4 +17,9 @@
 
 const BtorParserAPI* btor_parsesmt2_parser_api ();
 
+/* Parser for lemmas dumped via btor_dumpsmt_dump_lemmas. Declared symbols
+ * are bound to the existing nodes with the same symbol and sort, parsing
+ * stops at the first 'check-sat' command. */
+const BtorParserAPI* btor_parsesmt2_lemma_parser_api ();
+
 #endif
@@ -0,0 +1,719 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 Aina Niemetz.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorbvdomains.h"
+
+#include "btorbv.h"
+#include "btorbvprop.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btorsubst.h"
+#include "utils/btorhashint.h"
+#include "utils/btornodeiter.h"
+#include "utils/btorutil.h"
+
+/*------------------------------------------------------------------------*/
+
+static void
+free_absval (BtorMemMgr *mm, BtorBvAbsVal *v)
+{
+  btor_bv_free (mm, v->lo);
+  btor_bv_free (mm, v->hi);
+  btor_bv_free (mm, v->min);
+  btor_bv_free (mm, v->max);
+}
+
+static void
+set_top (BtorMemMgr *mm, BtorBvAbsVal *v, uint32_t width)
+{
+  v->lo  = btor_bv_new (mm, width);
+  v->hi  = btor_bv_ones (mm, width);
+  v->min = btor_bv_new (mm, width);
+  v->max = btor_bv_ones (mm, width);
+}
+
+static void
+set_const (BtorMemMgr *mm, BtorBvAbsVal *v, const BtorBitVector *bv)
+{
+  v->lo  = btor_bv_copy (mm, bv);
+  v->hi  = btor_bv_copy (mm, bv);
+  v->min = btor_bv_copy (mm, bv);
+  v->max = btor_bv_copy (mm, bv);
+}
+
+static void
+set_interval (BtorMemMgr *mm,
+              BtorBvAbsVal *v,
+              BtorBitVector *min,
+              BtorBitVector *max)
+{
+  btor_bv_free (mm, v->min);
+  btor_bv_free (mm, v->max);
+  v->min = min;
+  v->max = max;
+}
+
+static bool
+is_fixed (const BtorBvAbsVal *v)
+{
+  return btor_bv_compare (v->min, v->max) == 0;
+}
+
+/* Tighten the interval of 'v' by its fixed bits and fix the bits that are
+ * common to all values in the interval. */
+static void
+reduce (BtorMemMgr *mm, BtorBvAbsVal *v)
+{
+  uint32_t width, lz;
+  BtorBitVector *tmp, *ones, *mask, *fixed;
+
+  if (btor_bv_compare (v->min, v->lo) < 0)
+  {
+    btor_bv_free (mm, v->min);
+    v->min = btor_bv_copy (mm, v->lo);
+  }
+  if (btor_bv_compare (v->max, v->hi) > 0)
+  {
+    btor_bv_free (mm, v->max);
+    v->max = btor_bv_copy (mm, v->hi);
+  }
+  assert (btor_bv_compare (v->min, v->max) <= 0);
+
+  width = btor_bv_get_width (v->min);
+  tmp   = btor_bv_xor (mm, v->min, v->max);
+  lz    = btor_bv_get_num_leading_zeros (tmp);
+  btor_bv_free (mm, tmp);
+  if (!lz) return;
+
+  ones = btor_bv_ones (mm, width);
+  mask = btor_bv_sll_uint64 (mm, ones, width - lz);
+  btor_bv_free (mm, ones);
+
+  fixed = btor_bv_and (mm, v->min, mask);
+  tmp   = btor_bv_or (mm, v->lo, fixed);
+  btor_bv_free (mm, v->lo);
+  v->lo = tmp;
+  btor_bv_free (mm, fixed);
+
+  ones  = btor_bv_not (mm, mask);
+  fixed = btor_bv_or (mm, v->min, ones);
+  tmp   = btor_bv_and (mm, v->hi, fixed);
+  btor_bv_free (mm, v->hi);
+  v->hi = tmp;
+  btor_bv_free (mm, fixed);
+  btor_bv_free (mm, ones);
+  btor_bv_free (mm, mask);
+}
+
+/* Get a copy of the abstract value of edge 'exp' (inverted if 'exp' is
+ * inverted), all values if 'exp' has no abstract value. */
+static void
+get_edge (Btor *btor, BtorIntHashTable *vals, BtorNode *exp, BtorBvAbsVal *res)
+{
+  BtorMemMgr *mm;
+  BtorHashTableData *d;
+  BtorBvAbsVal *v;
+
+  mm = btor->mm;
+  d  = btor_hashint_map_get (vals, btor_node_real_addr (exp)->id);
+  if (!d)
+  {
+    set_top (mm, res, btor_node_bv_get_width (btor, exp));
+    return;
+  }
+  v = d->as_ptr;
+  if (btor_node_is_inverted (exp))
+  {
+    res->lo  = btor_bv_not (mm, v->hi);
+    res->hi  = btor_bv_not (mm, v->lo);
+    res->min = btor_bv_not (mm, v->max);
+    res->max = btor_bv_not (mm, v->min);
+  }
+  else
+  {
+    res->lo  = btor_bv_copy (mm, v->lo);
+    res->hi  = btor_bv_copy (mm, v->hi);
+    res->min = btor_bv_copy (mm, v->min);
+    res->max = btor_bv_copy (mm, v->max);
+  }
+}
+
+/* Number of trailing bits that are fixed in both 'a' and 'b'. */
+static uint32_t
+get_num_trailing_fixed (BtorMemMgr *mm,
+                        const BtorBvAbsVal *a,
+                        const BtorBvAbsVal *b)
+{
+  uint32_t res;
+  BtorBitVector *ua, *ub, *u;
+
+  ua  = btor_bv_xor (mm, a->lo, a->hi);
+  ub  = btor_bv_xor (mm, b->lo, b->hi);
+  u   = btor_bv_or (mm, ua, ub);
+  res = btor_bv_get_num_trailing_zeros (u);
+  btor_bv_free (mm, u);
+  btor_bv_free (mm, ub);
+  btor_bv_free (mm, ua);
+  return res;
+}
+
+/* Fix the 'n' least significant bits of 'v' to the bits of 'bits'. */
+static void
+set_trailing_bits (BtorMemMgr *mm,
+                   BtorBvAbsVal *v,
+                   const BtorBitVector *bits,
+                   uint32_t n)
+{
+  uint32_t width;
+  BtorBitVector *ones, *mask, *tmp, *tmp2;
+
+  if (!n) return;
+  width = btor_bv_get_width (bits);
+  ones  = btor_bv_ones (mm, width);
+  mask  = btor_bv_srl_uint64 (mm, ones, width - n);
+  btor_bv_free (mm, ones);
+
+  tmp   = btor_bv_and (mm, bits, mask);
+  tmp2  = btor_bv_or (mm, v->lo, tmp);
+  btor_bv_free (mm, v->lo);
+  v->lo = tmp2;
+  btor_bv_free (mm, tmp);
+
+  ones  = btor_bv_not (mm, mask);
+  tmp   = btor_bv_or (mm, bits, ones);
+  tmp2  = btor_bv_and (mm, v->hi, tmp);
+  btor_bv_free (mm, v->hi);
+  v->hi = tmp2;
+  btor_bv_free (mm, tmp);
+  btor_bv_free (mm, ones);
+  btor_bv_free (mm, mask);
+}
+
+/* Compute '[a.min op b.min, a.max op b.max]' with 'op' in { +, * } if no
+ * overflow occurs, or if both bounds overflow (addition only). */
+static void
+set_monotone_interval (BtorMemMgr *mm,
+                       BtorBvAbsVal *res,
+                       const BtorBvAbsVal *a,
+                       const BtorBvAbsVal *b,
+                       bool is_add)
+{
+  uint32_t width;
+  BtorBitVector *emin[2], *emax[2], *min, *max, *tmp;
+
+  width = btor_bv_get_width (a->min);
+  if (!is_add)
+  {
+    if (btor_bv_is_umulo (mm, a->max, b->max)) return;
+    set_interval (mm,
+                  res,
+                  btor_bv_mul (mm, a->min, b->min),
+                  btor_bv_mul (mm, a->max, b->max));
+    return;
+  }
+
+  emin[0] = btor_bv_uext (mm, a->min, 1);
+  emin[1] = btor_bv_uext (mm, b->min, 1);
+  emax[0] = btor_bv_uext (mm, a->max, 1);
+  emax[1] = btor_bv_uext (mm, b->max, 1);
+  min     = btor_bv_add (mm, emin[0], emin[1]);
+  max     = btor_bv_add (mm, emax[0], emax[1]);
+  if (btor_bv_get_bit (min, width) == btor_bv_get_bit (max, width))
+  {
+    tmp = btor_bv_slice (mm, min, width - 1, 0);
+    set_interval (mm, res, tmp, btor_bv_slice (mm, max, width - 1, 0));
+  }
+  btor_bv_free (mm, min);
+  btor_bv_free (mm, max);
+  btor_bv_free (mm, emin[0]);
+  btor_bv_free (mm, emin[1]);
+  btor_bv_free (mm, emax[0]);
+  btor_bv_free (mm, emax[1]);
+}
+
+/* Compute the abstract value of 'exp' from the abstract values of its
+ * children (forward only). */
+static void
+eval (Btor *btor, BtorIntHashTable *vals, BtorNode *exp, BtorBvAbsVal *res)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t i, width, upper, lower, n;
+  BtorMemMgr *mm;
+  BtorBvAbsVal e[3];
+  BtorBitVector *tmp, *tmp2;
+
+  mm    = btor->mm;
+  width = btor_node_bv_get_width (btor, exp);
+
+  if (btor_node_is_bv_const (exp))
+  {
+    set_const (mm, res, btor_node_bv_const_get_bits (exp));
+    return;
+  }
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_CONCAT_NODE:
+    case BTOR_BV_SLICE_NODE:
+    case BTOR_COND_NODE: break;
+    default: set_top (mm, res, width); return;
+  }
+
+  for (i = 0; i < exp->arity; i++) get_edge (btor, vals, exp->e[i], &e[i]);
+  set_top (mm, res, width);
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_AND_NODE:
+      free_absval (mm, res);
+      res->lo  = btor_bv_and (mm, e[0].lo, e[1].lo);
+      res->hi  = btor_bv_and (mm, e[0].hi, e[1].hi);
+      res->min = btor_bv_new (mm, width);
+      res->max = btor_bv_compare (e[0].max, e[1].max) < 0
+                     ? btor_bv_copy (mm, e[0].max)
+                     : btor_bv_copy (mm, e[1].max);
+      break;
+
+    case BTOR_BV_EQ_NODE:
+      tmp  = btor_bv_not (mm, e[1].hi);
+      tmp2 = btor_bv_and (mm, e[0].lo, tmp);
+      btor_bv_free (mm, tmp);
+      n = !btor_bv_is_zero (tmp2);
+      btor_bv_free (mm, tmp2);
+      tmp  = btor_bv_not (mm, e[0].hi);
+      tmp2 = btor_bv_and (mm, e[1].lo, tmp);
+      btor_bv_free (mm, tmp);
+      n = n || !btor_bv_is_zero (tmp2);
+      btor_bv_free (mm, tmp2);
+      if (n || btor_bv_compare (e[0].max, e[1].min) < 0
+          || btor_bv_compare (e[1].max, e[0].min) < 0)
+      {
+        free_absval (mm, res);
+        tmp = btor_bv_new (mm, 1);
+        set_const (mm, res, tmp);
+        btor_bv_free (mm, tmp);
+      }
+      else if (is_fixed (&e[0]) && is_fixed (&e[1]))
+      {
+        assert (!btor_bv_compare (e[0].min, e[1].min));
+        free_absval (mm, res);
+        tmp = btor_bv_one (mm, 1);
+        set_const (mm, res, tmp);
+        btor_bv_free (mm, tmp);
+      }
+      break;
+
+    case BTOR_BV_ULT_NODE:
+      if (btor_bv_compare (e[0].max, e[1].min) < 0)
+        tmp = btor_bv_one (mm, 1);
+      else if (btor_bv_compare (e[0].min, e[1].max) >= 0)
+        tmp = btor_bv_new (mm, 1);
+      else
+        break;
+      free_absval (mm, res);
+      set_const (mm, res, tmp);
+      btor_bv_free (mm, tmp);
+      break;
+
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+      /* trailing bits that are fixed in both operands are fixed */
+      n   = get_num_trailing_fixed (mm, &e[0], &e[1]);
+      tmp = exp->kind == BTOR_BV_ADD_NODE ? btor_bv_add (mm, e[0].lo, e[1].lo)
+                                          : btor_bv_mul (mm, e[0].lo, e[1].lo);
+      set_trailing_bits (mm, res, tmp, n);
+      btor_bv_free (mm, tmp);
+      if (exp->kind == BTOR_BV_MUL_NODE)
+      {
+        /* trailing zeros of the operands are trailing zeros of the result */
+        n = btor_bv_get_num_trailing_zeros (e[0].hi)
+            + btor_bv_get_num_trailing_zeros (e[1].hi);
+        n   = n > width ? width : n;
+        tmp = btor_bv_new (mm, width);
+        set_trailing_bits (mm, res, tmp, n);
+        btor_bv_free (mm, tmp);
+      }
+      set_monotone_interval (
+          mm, res, &e[0], &e[1], exp->kind == BTOR_BV_ADD_NODE);
+      break;
+
+    case BTOR_BV_UDIV_NODE:
+      /* division by zero yields ones */
+      if (btor_bv_is_zero (e[1].max))
+        set_interval (
+            mm, res, btor_bv_ones (mm, width), btor_bv_ones (mm, width));
+      else if (btor_bv_is_zero (e[1].min))
+        set_interval (mm,
+                      res,
+                      btor_bv_udiv (mm, e[0].min, e[1].max),
+                      btor_bv_ones (mm, width));
+      else
+        set_interval (mm,
+                      res,
+                      btor_bv_udiv (mm, e[0].min, e[1].max),
+                      btor_bv_udiv (mm, e[0].max, e[1].min));
+      break;
+
+    case BTOR_BV_UREM_NODE:
+      /* remainder by zero yields the dividend */
+      if (btor_bv_compare (e[0].max, e[1].min) < 0)
+      {
+        free_absval (mm, res);
+        get_edge (btor, vals, exp->e[0], res);
+      }
+      else if (btor_bv_is_zero (e[1].min)
+               || btor_bv_compare (e[0].max, e[1].max) < 0)
+        set_interval (
+            mm, res, btor_bv_new (mm, width), btor_bv_copy (mm, e[0].max));
+      else
+        set_interval (
+            mm, res, btor_bv_new (mm, width), btor_bv_dec (mm, e[1].max));
+      break;
+
+    case BTOR_BV_SLL_NODE:
+      if (!is_fixed (&e[1])) break;
+      free_absval (mm, res);
+      res->lo = btor_bv_sll (mm, e[0].lo, e[1].min);
+      res->hi = btor_bv_sll (mm, e[0].hi, e[1].min);
+      tmp     = btor_bv_sll (mm, e[0].max, e[1].min);
+      tmp2    = btor_bv_srl (mm, tmp, e[1].min);
+      if (btor_bv_compare (tmp2, e[0].max) == 0)
+      {
+        res->min = btor_bv_sll (mm, e[0].min, e[1].min);
+        res->max = tmp;
+      }
+      else
+      {
+        res->min = btor_bv_new (mm, width);
+        res->max = btor_bv_ones (mm, width);
+        btor_bv_free (mm, tmp);
+      }
+      btor_bv_free (mm, tmp2);
+      break;
+
+    case BTOR_BV_SRL_NODE:
+      if (is_fixed (&e[1]))
+      {
+        btor_bv_free (mm, res->lo);
+        btor_bv_free (mm, res->hi);
+        res->lo = btor_bv_srl (mm, e[0].lo, e[1].min);
+        res->hi = btor_bv_srl (mm, e[0].hi, e[1].min);
+      }
+      set_interval (mm,
+                    res,
+                    btor_bv_srl (mm, e[0].min, e[1].max),
+                    btor_bv_srl (mm, e[0].max, e[1].min));
+      break;
+
+    case BTOR_BV_CONCAT_NODE:
+      free_absval (mm, res);
+      res->lo  = btor_bv_concat (mm, e[0].lo, e[1].lo);
+      res->hi  = btor_bv_concat (mm, e[0].hi, e[1].hi);
+      res->min = btor_bv_concat (mm, e[0].min, e[1].min);
+      res->max = btor_bv_concat (mm, e[0].max, e[1].max);
+      break;
+
+    case BTOR_BV_SLICE_NODE:
+      upper = btor_node_bv_slice_get_upper (exp);
+      lower = btor_node_bv_slice_get_lower (exp);
+      btor_bv_free (mm, res->lo);
+      btor_bv_free (mm, res->hi);
+      res->lo = btor_bv_slice (mm, e[0].lo, upper, lower);
+      res->hi = btor_bv_slice (mm, e[0].hi, upper, lower);
+      /* the interval is preserved if all values agree above 'upper' */
+      tmp  = btor_bv_srl_uint64 (mm, e[0].min, upper + 1);
+      tmp2 = btor_bv_srl_uint64 (mm, e[0].max, upper + 1);
+      if (btor_bv_compare (tmp, tmp2) == 0)
+        set_interval (mm,
+                      res,
+                      btor_bv_slice (mm, e[0].min, upper, lower),
+                      btor_bv_slice (mm, e[0].max, upper, lower));
+      btor_bv_free (mm, tmp);
+      btor_bv_free (mm, tmp2);
+      break;
+
+    default:
+      assert (exp->kind == BTOR_COND_NODE);
+      free_absval (mm, res);
+      if (btor_bv_is_one (e[0].min))
+        get_edge (btor, vals, exp->e[1], res);
+      else if (btor_bv_is_zero (e[0].max))
+        get_edge (btor, vals, exp->e[2], res);
+      else
+      {
+        res->lo  = btor_bv_and (mm, e[1].lo, e[2].lo);
+        res->hi  = btor_bv_or (mm, e[1].hi, e[2].hi);
+        res->min = btor_bv_compare (e[1].min, e[2].min) < 0
+                       ? btor_bv_copy (mm, e[1].min)
+                       : btor_bv_copy (mm, e[2].min);
+        res->max = btor_bv_compare (e[1].max, e[2].max) > 0
+                       ? btor_bv_copy (mm, e[1].max)
+                       : btor_bv_copy (mm, e[2].max);
+      }
+  }
+
+  for (i = 0; i < exp->arity; i++) free_absval (mm, &e[i]);
+  reduce (mm, res);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+collect_cone (Btor *btor, BtorNodePtrStack *nodes)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *cache;
+
+  BTOR_INIT_STACK (btor->mm, visit);
+  cache = btor_hashint_table_new (btor->mm);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (visit, btor_iter_hashptr_next (&it));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+    if (!cur->parameterized && btor_sort_is_bv (btor, cur->sort_id))
+      BTOR_PUSH_STACK (*nodes, cur);
+  }
+  btor_hashint_table_delete (cache);
+  BTOR_RELEASE_STACK (visit);
+
+  /* children before parents */
+  qsort (nodes->start,
+         BTOR_COUNT_STACK (*nodes),
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+}
+
+/* Substitute bit-vector variables with fixed bits by a concatenation of
+ * constants (fixed bits) and fresh variables (unconstrained bits).
+ * Returns the number of substituted variables. */
+static uint32_t
+fix_var_bits (Btor *btor, BtorIntHashTable *domains, uint32_t *num_bits)
+{
+  uint32_t i, j, width, num_vars;
+  bool fixed;
+  BtorMemMgr *mm;
+  BtorNode *var, *part, *res, *tmp;
+  BtorPtrHashTableIterator it;
+  BtorBvDomain *d;
+  BtorBitVector *bits;
+  BtorSortId sort;
+
+  mm       = btor->mm;
+  num_vars = 0;
+
+  btor_iter_hashptr_init (&it, btor->bv_vars);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    var = btor_iter_hashptr_next (&it);
+    if (btor_node_is_simplified (var)) continue;
+    d = btor_bvprop_get_domain (mm, domains, var);
+    if (!d) continue;
+    if (!btor_bvprop_has_fixed_bits (mm, d))
+    {
+      btor_bvprop_free (mm, d);
+      continue;
+    }
+
+    /* concatenate maximal ranges of fixed and unconstrained bits, starting
+     * from the most significant bit */
+    width = btor_node_bv_get_width (btor, var);
+    res   = 0;
+    for (i = width; i > 0; i = j)
+    {
+      fixed = btor_bv_get_bit (d->lo, i - 1) || !btor_bv_get_bit (d->hi, i - 1);
+      for (j = i - 1; j > 0; j--)
+        if (fixed
+            != (btor_bv_get_bit (d->lo, j - 1)
+                || !btor_bv_get_bit (d->hi, j - 1)))
+          break;
+      if (fixed)
+      {
+        bits = btor_bv_slice (mm, d->lo, i - 1, j);
+        part = btor_exp_bv_const (btor, bits);
+        btor_bv_free (mm, bits);
+        *num_bits += i - j;
+      }
+      else
+      {
+        sort = btor_sort_bv (btor, i - j);
+        part = btor_exp_var (btor, sort, 0);
+        btor_sort_release (btor, sort);
+      }
+      if (res)
+      {
+        tmp = btor_exp_bv_concat (btor, res, part);
+        btor_node_release (btor, res);
+        btor_node_release (btor, part);
+        res = tmp;
+      }
+      else
+        res = part;
+    }
+    btor_bvprop_free (mm, d);
+
+    BTORLOG (2,
+             "fix bits of %s: %s",
+             btor_util_node2string (var),
+             btor_util_node2string (res));
+    num_vars += 1;
+    tmp = btor_exp_eq (btor, var, res);
+    btor_assert_exp (btor, tmp);
+    btor_node_release (btor, tmp);
+    btor_node_release (btor, res);
+  }
+  return num_vars;
+}
+
+BtorIntHashTable *
+btor_bvdomains_compute_absvals (Btor *btor, BtorNodePtrStack *nodes)
+{
+  assert (btor);
+  assert (nodes);
+
+  uint32_t i;
+  BtorNode *cur;
+  BtorIntHashTable *vals;
+  BtorBvAbsVal *v;
+
+  collect_cone (btor, nodes);
+  vals = btor_hashint_map_new (btor->mm);
+  for (i = 0; i < BTOR_COUNT_STACK (*nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (*nodes, i);
+    BTOR_CNEW (btor->mm, v);
+    eval (btor, vals, cur, v);
+    btor_hashint_map_add (vals, cur->id)->as_ptr = v;
+  }
+  return vals;
+}
+
+void
+btor_bvdomains_delete_absvals (Btor *btor, BtorIntHashTable *vals)
+{
+  assert (btor);
+  assert (vals);
+
+  BtorIntHashTableIterator it;
+  BtorBvAbsVal *v;
+
+  btor_iter_hashint_init (&it, vals);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    v = btor_iter_hashint_next_data (&it)->as_ptr;
+    free_absval (btor->mm, v);
+    BTOR_DELETE (btor->mm, v);
+  }
+  btor_hashint_map_delete (vals);
+}
+
+/* Substitute terms whose value is determined by their forward abstract
+ * value by constants. Returns the number of substituted terms. */
+static uint32_t
+substitute_fixed_terms (Btor *btor)
+{
+  uint32_t i, num_terms;
+  BtorNode *cur, *c;
+  BtorNodePtrStack nodes;
+  BtorIntHashTable *vals;
+  BtorBvAbsVal *v;
+
+  BTOR_INIT_STACK (btor->mm, nodes);
+  vals = btor_bvdomains_compute_absvals (btor, &nodes);
+
+  btor_init_substitutions (btor);
+  for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (nodes, i);
+    v   = btor_hashint_map_get (vals, cur->id)->as_ptr;
+    if (!btor_node_is_bv_const (cur) && is_fixed (v))
+    {
+      c = btor_exp_bv_const (btor, v->min);
+      btor_insert_substitution (btor, cur, c, false);
+      btor_node_release (btor, c);
+    }
+  }
+  num_terms = btor->substitutions->count;
+
+  btor_bvdomains_delete_absvals (btor, vals);
+  BTOR_RELEASE_STACK (nodes);
+
+  btor_substitute_and_rebuild (btor, btor->substitutions);
+  btor_delete_substitutions (btor);
+  return num_terms;
+}
+
+void
+btor_process_bv_domains (Btor *btor)
+{
+  assert (btor);
+  assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
+
+  uint32_t num_vars, num_bits, num_terms;
+  double start, delta;
+  BtorIntHashTable *domains;
+
+  start     = btor_util_time_stamp ();
+  num_vars  = 0;
+  num_bits  = 0;
+  num_terms = 0;
+
+  BTORLOG (1, "start bit-vector domain simplification");
+
+  /* fixed bits of variables are implied by the constraints */
+  domains = btor_bvprop_compute_domains (btor, BTOR_BV_DOMAINS_MAX_ROUNDS);
+  if (!domains)
+  {
+    btor->inconsistent = true;
+    goto DONE;
+  }
+  num_vars = fix_var_bits (btor, domains, &num_bits);
+  btor_bvprop_delete_domains (btor, domains);
+
+  /* The forward analysis must not rely on the domains computed above since
+   * they are (partially) derived from the constraints that would be
+   * simplified. Fixed bits of variables are only considered after they have
+   * been made explicit via variable substitution. */
+  if (!num_vars && !btor->inconsistent)
+    num_terms = substitute_fixed_terms (btor);
+
+DONE:
+  btor->stats.bv_domain_vars += num_vars;
+  btor->stats.bv_domain_bits += num_bits;
+  btor->stats.bv_domain_terms += num_terms;
+  delta = btor_util_time_stamp () - start;
+  btor->time.bvdomains += delta;
+  BTORLOG (1, "end bit-vector domain simplification");
+  BTOR_MSG (btor->msg,
+            1,
+            "fixed %u bits of %u variables, substituted %u terms in %.3f "
+            "seconds",
+            num_bits,
+            num_vars,
+            num_terms,
+            delta);
+}
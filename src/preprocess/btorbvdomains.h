@@ -0,0 +1,55 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 Aina Niemetz.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORBVDOMAINS_H_INCLUDED
+#define BTORBVDOMAINS_H_INCLUDED
+
+#include "btorbv.h"
+#include "btornode.h"
+#include "btortypes.h"
+#include "utils/btorhashint.h"
+
+/* Maximum number of propagation rounds when computing fixed-bit domains. */
+#define BTOR_BV_DOMAINS_MAX_ROUNDS 16
+
+/* Simplify bit-vector terms based on abstract domains (fixed bits and
+ * unsigned intervals).
+ *
+ * Bits of bit-vector variables that are fixed by the constraints (computed by
+ * forward and backward fixed-bit propagation) are made explicit by
+ * substituting the variable with a concatenation of constants and fresh
+ * variables for the remaining bits. If no variable was substituted, terms
+ * whose value is determined by a forward-only analysis of fixed bits and
+ * unsigned intervals (e.g., comparisons that can only be true or false) are
+ * substituted by constants. */
+void btor_process_bv_domains (Btor *btor);
+
+/*------------------------------------------------------------------------*/
+
+/* Abstract value of a bit-vector node: fixed bits as in BtorBvDomain and an
+ * unsigned interval [min, max]. */
+struct BtorBvAbsVal
+{
+  BtorBitVector *lo;
+  BtorBitVector *hi;
+  BtorBitVector *min;
+  BtorBitVector *max;
+};
+typedef struct BtorBvAbsVal BtorBvAbsVal;
+
+/* Compute the forward abstract values of all (non-parameterized) bit-vector
+ * nodes in the cone of the constraints, which are pushed onto 'nodes' in
+ * ascending id order (children before parents).
+ * Returns a map from node ids to abstract values (as_ptr) of the regular
+ * nodes. */
+BtorIntHashTable *btor_bvdomains_compute_absvals (Btor *btor,
+                                                  BtorNodePtrStack *nodes);
+
+void btor_bvdomains_delete_absvals (Btor *btor, BtorIntHashTable *vals);
+
+#endif
@@ -0,0 +1,324 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 Aina Niemetz.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorbvwidth.h"
+
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btorsubst.h"
+#include "preprocess/btorbvdomains.h"
+#include "utils/btorhashint.h"
+#include "utils/btorutil.h"
+
+/*------------------------------------------------------------------------*/
+
+/* Number of least significant bits of (possibly inverted) 'exp' that are not
+ * known to be zero. */
+static uint32_t
+get_unsigned_width (Btor *btor, BtorIntHashTable *vals, BtorNode *exp)
+{
+  BtorHashTableData *d;
+  BtorBvAbsVal *v;
+  uint32_t width;
+
+  width = btor_node_bv_get_width (btor, exp);
+  d     = btor_hashint_map_get (vals, btor_node_real_addr (exp)->id);
+  if (!d) return width;
+  v = d->as_ptr;
+  if (btor_node_is_inverted (exp))
+    return width - btor_bv_get_num_leading_ones (v->lo);
+  return width - btor_bv_get_num_leading_zeros (v->hi);
+}
+
+/* Number of most significant bits of (possibly inverted) 'exp' that are known
+ * to be equal, at least 1. */
+static uint32_t
+get_sign_bits (BtorIntHashTable *signs, BtorNode *exp)
+{
+  BtorHashTableData *d;
+
+  d = btor_hashint_map_get (signs, btor_node_real_addr (exp)->id);
+  return d ? (uint32_t) d->as_int : 1;
+}
+
+/* Check if (possibly inverted) constant 'exp' is 'ones' or 'zero'. */
+static bool
+is_const_ones (BtorNode *exp)
+{
+  BtorBitVector *bits;
+
+  bits = btor_node_bv_const_get_bits (btor_node_real_addr (exp));
+  return btor_node_is_inverted (exp) ? btor_bv_is_zero (bits)
+                                     : btor_bv_is_ones (bits);
+}
+
+static bool
+is_const_zero (BtorNode *exp)
+{
+  return is_const_ones (btor_node_invert (exp));
+}
+
+/* Check if 'ext' is the sign extension of 'exp' as created by
+ * btor_exp_bv_sext, i.e., (possibly inverted) 'ite (msb (exp), ones, zero)'
+ * or 'msb (exp)' for extensions by one bit. */
+static bool
+is_sign_ext (Btor *btor, BtorNode *ext, BtorNode *exp)
+{
+  bool pol;
+  uint32_t width;
+  BtorNode *real_ext, *cond, *slice, *t, *e, *msb1, *msb0;
+
+  width    = btor_node_bv_get_width (btor, exp);
+  real_ext = btor_node_real_addr (ext);
+
+  if (btor_node_is_bv_slice (real_ext))
+    cond = ext;
+  else if (btor_node_is_bv_cond (real_ext))
+    cond = real_ext->e[0];
+  else
+    return false;
+
+  slice = btor_node_real_addr (cond);
+  if (!btor_node_is_bv_slice (slice)
+      || btor_node_real_addr (slice->e[0]) != btor_node_real_addr (exp)
+      || btor_node_bv_slice_get_upper (slice) != width - 1
+      || btor_node_bv_slice_get_lower (slice) != width - 1)
+    return false;
+
+  /* 'cond' is the msb of 'exp' if 'pol' is true, its negation otherwise */
+  pol = !(btor_node_is_inverted (cond) ^ btor_node_is_inverted (slice->e[0])
+          ^ btor_node_is_inverted (exp));
+
+  if (cond == ext) return pol;
+
+  t = real_ext->e[1];
+  e = real_ext->e[2];
+  if (!btor_node_is_bv_const (t) || !btor_node_is_bv_const (e)) return false;
+
+  /* value of 'ext' if the msb of 'exp' is 1 and 0, respectively */
+  msb1 = btor_node_cond_invert (ext, pol ? t : e);
+  msb0 = btor_node_cond_invert (ext, pol ? e : t);
+  return is_const_ones (msb1) && is_const_zero (msb0);
+}
+
+static uint32_t
+compute_sign_bits (Btor *btor, BtorIntHashTable *signs, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t width, w0, s0, s1, upper, lower;
+  BtorBitVector *bits;
+
+  width = btor_node_bv_get_width (btor, exp);
+  switch (exp->kind)
+  {
+    case BTOR_BV_CONST_NODE:
+      bits = btor_node_bv_const_get_bits (exp);
+      return btor_bv_get_bit (bits, width - 1)
+                 ? btor_bv_get_num_leading_ones (bits)
+                 : btor_bv_get_num_leading_zeros (bits);
+
+    case BTOR_BV_CONCAT_NODE:
+      w0 = btor_node_bv_get_width (btor, exp->e[0]);
+      if (is_sign_ext (btor, exp->e[0], exp->e[1]))
+        return w0 + get_sign_bits (signs, exp->e[1]);
+      return get_sign_bits (signs, exp->e[0]);
+
+    case BTOR_BV_SLICE_NODE:
+      upper = btor_node_bv_slice_get_upper (exp);
+      lower = btor_node_bv_slice_get_lower (exp);
+      w0    = btor_node_bv_get_width (btor, exp->e[0]);
+      s0    = get_sign_bits (signs, exp->e[0]);
+      if (w0 - upper > s0) return 1;
+      s0 -= w0 - 1 - upper;
+      return s0 > upper - lower + 1 ? upper - lower + 1 : s0;
+
+    case BTOR_BV_AND_NODE:
+      s0 = get_sign_bits (signs, exp->e[0]);
+      s1 = get_sign_bits (signs, exp->e[1]);
+      return s0 < s1 ? s0 : s1;
+
+    case BTOR_COND_NODE:
+      s0 = get_sign_bits (signs, exp->e[1]);
+      s1 = get_sign_bits (signs, exp->e[2]);
+      return s0 < s1 ? s0 : s1;
+
+    case BTOR_BV_ADD_NODE:
+      s0 = get_sign_bits (signs, exp->e[0]);
+      s1 = get_sign_bits (signs, exp->e[1]);
+      s0 = s0 < s1 ? s0 : s1;
+      return s0 > 1 ? s0 - 1 : 1;
+
+    case BTOR_BV_MUL_NODE:
+      /* the product of signed terms with 's0' and 's1' significant bits has
+       * at most 's0 + s1' significant bits */
+      s0 = width - get_sign_bits (signs, exp->e[0]) + 1;
+      s1 = width - get_sign_bits (signs, exp->e[1]) + 1;
+      return s0 + s1 <= width ? width - (s0 + s1) + 1 : 1;
+
+    default: return 1;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Create 'exp' with kind and children of 'exp' where the bit-vector operands
+ * are truncated to 'width' bits. */
+static BtorNode *
+create_truncated (Btor *btor, BtorNode *exp, uint32_t width)
+{
+  uint32_t i;
+  BtorNode *e[3], *res;
+
+  for (i = 0; i < exp->arity; i++)
+  {
+    if (btor_node_is_cond (exp) && i == 0)
+      e[i] = btor_node_copy (btor, exp->e[i]);
+    else
+      e[i] = btor_exp_bv_slice (btor, exp->e[i], width - 1, 0);
+  }
+  res = btor_exp_create (btor, exp->kind, e, exp->arity);
+  for (i = 0; i < exp->arity; i++) btor_node_release (btor, e[i]);
+  return res;
+}
+
+/* Determine the reduced (operand) width 'rwidth' of 'exp' with (operand)
+ * width 'width', and if the result is sign or zero extended to the original
+ * width. Returns false if 'exp' can not be reduced. */
+static bool
+get_reduced_width (Btor *btor,
+                   BtorIntHashTable *vals,
+                   BtorIntHashTable *signs,
+                   BtorNode *exp,
+                   uint32_t *width,
+                   uint32_t *rwidth,
+                   bool *is_signed)
+{
+  uint32_t uw, sw, u0, u1, s0, s1;
+
+  switch (exp->kind)
+  {
+    /* low result bits only depend on low operand bits */
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_COND_NODE:
+      *width = btor_node_bv_get_width (btor, exp);
+      uw     = get_unsigned_width (btor, vals, exp);
+      sw     = *width - get_sign_bits (signs, exp) + 1;
+      break;
+
+    /* operands must be representable with the reduced width */
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+      *width = btor_node_bv_get_width (btor, exp->e[0]);
+      u0     = get_unsigned_width (btor, vals, exp->e[0]);
+      u1     = get_unsigned_width (btor, vals, exp->e[1]);
+      uw     = u0 > u1 ? u0 : u1;
+      sw     = *width;
+      if (exp->kind == BTOR_BV_EQ_NODE)
+      {
+        s0 = get_sign_bits (signs, exp->e[0]);
+        s1 = get_sign_bits (signs, exp->e[1]);
+        sw = *width - (s0 < s1 ? s0 : s1) + 1;
+      }
+      /* division by zero yields ones, which is only preserved if the result
+       * is not known to be zero-extended */
+      else if (exp->kind == BTOR_BV_UDIV_NODE
+               && get_unsigned_width (btor, vals, exp) > uw)
+        uw = *width;
+      break;
+
+    default: return false;
+  }
+
+  if (!uw) uw = 1;
+  *is_signed = sw < uw;
+  *rwidth    = *is_signed ? sw : uw;
+  return *rwidth < *width;
+}
+
+void
+btor_reduce_bv_widths (Btor *btor)
+{
+  assert (btor);
+
+  bool is_signed;
+  uint32_t i, width, rwidth, num_terms, num_bits;
+  double start, delta;
+  BtorMemMgr *mm;
+  BtorNode *cur, *trunc, *subst;
+  BtorNodePtrStack nodes;
+  BtorIntHashTable *vals, *signs;
+
+  start     = btor_util_time_stamp ();
+  mm        = btor->mm;
+  num_terms = 0;
+  num_bits  = 0;
+
+  BTORLOG (1, "start bit-width reduction");
+
+  BTOR_INIT_STACK (mm, nodes);
+  vals  = btor_bvdomains_compute_absvals (btor, &nodes);
+  signs = btor_hashint_map_new (mm);
+
+  btor_init_substitutions (btor);
+  for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (nodes, i);
+    assert (btor_node_is_regular (cur));
+    btor_hashint_map_add (signs, cur->id)->as_int =
+        compute_sign_bits (btor, signs, cur);
+
+    if (!get_reduced_width (
+            btor, vals, signs, cur, &width, &rwidth, &is_signed))
+      continue;
+
+    trunc = create_truncated (btor, cur, rwidth);
+    if (btor_node_bv_get_width (btor, cur) == 1)
+      subst = trunc;
+    else
+    {
+      subst = is_signed ? btor_exp_bv_sext (btor, trunc, width - rwidth)
+                        : btor_exp_bv_uext (btor, trunc, width - rwidth);
+      btor_node_release (btor, trunc);
+    }
+    BTORLOG (2,
+             "reduce %s to %u bits: %s",
+             btor_util_node2string (cur),
+             rwidth,
+             btor_util_node2string (subst));
+    btor_insert_substitution (btor, cur, subst, false);
+    btor_node_release (btor, subst);
+    num_terms += 1;
+    num_bits += width - rwidth;
+  }
+
+  btor_hashint_map_delete (signs);
+  btor_bvdomains_delete_absvals (btor, vals);
+  BTOR_RELEASE_STACK (nodes);
+
+  btor_substitute_and_rebuild (btor, btor->substitutions);
+  btor_delete_substitutions (btor);
+
+  btor->stats.bv_width_terms += num_terms;
+  btor->stats.bv_width_bits += num_bits;
+  delta = btor_util_time_stamp () - start;
+  btor->time.bvwidth += delta;
+  BTORLOG (1, "end bit-width reduction");
+  BTOR_MSG (btor->msg,
+            1,
+            "reduced width of %u terms by %u bits in %.3f seconds",
+            num_terms,
+            num_bits,
+            delta);
+}
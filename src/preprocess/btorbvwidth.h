@@ -0,0 +1,20 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 Aina Niemetz.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORBVWIDTH_H_INCLUDED
+#define BTORBVWIDTH_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Reduce the bit-width of arithmetic, bit-wise and comparison operations
+ * whose upper bits are known to be zero (unsigned) or copies of the sign bit
+ * of the lower bits (signed), e.g., the sum of two zero-extended 8-bit terms
+ * is computed with 9 bits and zero-extended. */
+void btor_reduce_bv_widths (Btor *btor);
+
+#endif
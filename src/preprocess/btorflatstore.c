@@ -0,0 +1,733 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 Mathias Preiner.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorflatstore.h"
+
+#include "btorcore.h"
+#include "utils/btorhashint.h"
+#include "utils/btorhashptr.h"
+#include "utils/btorstack.h"
+#include "utils/btorutil.h"
+
+/* A range write as created when extracting memset, index to index and
+ * memcpy patterns (see btorextract.c), i.e., a lambda
+ *
+ *   \p . lower <= p <= upper && (upper - p) % step = 0 ? v : a[p]
+ *
+ * with constant 'lower' and 'upper'.  The ranges of a chain are organized as
+ * interval tree, which is represented as array sorted by 'lower', where the
+ * root of a subarray is its middle element and 'max_upper' is the maximum
+ * upper bound of all ranges in the subarray it is the root of.
+ */
+struct BtorFlatStoreRange
+{
+  BtorBitVector *lower;
+  BtorBitVector *upper;
+  BtorBitVector *step;      /* 0 if all indices in [lower, upper] are written */
+  BtorBitVector *max_upper; /* not owned */
+  uint32_t pos;             /* position of the write in the chain */
+};
+
+typedef struct BtorFlatStoreRange BtorFlatStoreRange;
+
+BTOR_DECLARE_STACK (BtorFlatStoreRange, BtorFlatStoreRange);
+
+/* A flattened chain of constant-index writes and range writes.
+ *
+ * The writes of the chain are stored bottom-up in 'writes', i.e., position 0
+ * is the write directly above 'base'.  'index' maps each index value to the
+ * (ascending) positions of the writes that write to this index.  Hence, the
+ * write that defines the value of index i for the write at position k is the
+ * greatest position <= k in the position list of i, or the greatest position
+ * <= k of all ranges in 'ranges' that contain i, whichever is greater.
+ *
+ * Note: Write chains may share a common suffix.  In this case, 'base' is a
+ * write of another flattened chain and lookups continue in that chain.
+ *
+ * Flat stores do not hold references to the nodes of the chain.  They are
+ * rebuilt on every call to btor_simplify and only used for nodes that are
+ * still part of the formula, which keep all nodes of the chain below alive.
+ */
+struct BtorFlatStore
+{
+  int32_t top_id;          /* id of the top-most write of the chain */
+  BtorNode *base;          /* array below the bottom-most write */
+  BtorNodePtrStack writes; /* writes ordered bottom-up */
+  BtorIntHashTable *pos;   /* maps ids of writes to positions */
+  BtorPtrHashTable *index; /* maps index values to BtorUIntStack positions */
+  BtorFlatStoreRangeStack ranges; /* interval tree of range writes */
+};
+
+typedef struct BtorFlatStore BtorFlatStore;
+
+/*------------------------------------------------------------------------*/
+
+#define BTOR_CONST_GET_BITS(c)                                   \
+  btor_node_is_inverted (c) ? btor_node_bv_const_get_invbits (c) \
+                            : btor_node_bv_const_get_bits (c)
+
+/* Check whether 'exp' is a read a[param] on a non-parameterized array. */
+static bool
+is_param_read (Btor *btor, BtorNode *exp, BtorNode *param)
+{
+  return !btor_node_is_inverted (exp) && btor_node_is_apply (exp)
+         && !exp->e[0]->parameterized
+         && btor_node_args_get_arity (btor, exp->e[1]) == 1
+         && exp->e[1]->e[0] == param;
+}
+
+/* Check whether 'fun' is a write with a constant index, either represented as
+ * update node or as lambda of the form \p . p = i ? v : a[p]. */
+static bool
+is_const_write (Btor *btor, BtorNode *fun, BtorNode **array, BtorNode **index)
+{
+  assert (btor_node_is_regular (fun));
+
+  BtorNode *param, *body, *eq, *app, *idx;
+
+  if (btor_node_is_update (fun))
+  {
+    if (btor_node_args_get_arity (btor, fun->e[1]) != 1) return false;
+    idx = fun->e[1]->e[0];
+    if (!btor_node_is_bv_const (idx)) return false;
+    *array = fun->e[0];
+    *index = idx;
+    return true;
+  }
+
+  if (!btor_node_is_lambda (fun) || fun->parameterized
+      || btor_node_fun_get_arity (btor, fun) > 1
+      || btor_node_lambda_get_static_rho (fun))
+    return false;
+
+  param = fun->e[0];
+  body  = btor_node_binder_get_body (fun);
+
+  if (btor_node_is_inverted (body) || !btor_node_is_bv_cond (body))
+    return false;
+
+  eq = body->e[0];
+  if (btor_node_is_inverted (eq) || !btor_node_is_bv_eq (eq)) return false;
+
+  if (eq->e[0] == param)
+    idx = eq->e[1];
+  else if (eq->e[1] == param)
+    idx = eq->e[0];
+  else
+    return false;
+
+  if (!btor_node_is_bv_const (idx)) return false;
+
+  /* value must not depend on the index */
+  if (btor_node_real_addr (body->e[1])->parameterized) return false;
+
+  /* else branch must be a read on the unmodified array */
+  app = body->e[2];
+  if (!is_param_read (btor, app, param)) return false;
+
+  *array = app->e[0];
+  *index = idx;
+  return true;
+}
+
+static int32_t
+compare_bv_qsort (const void *a, const void *b)
+{
+  return btor_bv_compare (*(BtorBitVector **) a, *(BtorBitVector **) b);
+}
+
+/* Check whether the indices in 'static_rho' are exactly the indices
+ * lower, lower + step, ..., upper and determine 'step'. */
+static bool
+is_range_static_rho (Btor *btor,
+                     BtorPtrHashTable *static_rho,
+                     const BtorBitVector *lower,
+                     const BtorBitVector *upper,
+                     BtorBitVector **step)
+{
+  bool res;
+  uint32_t i;
+  BtorNode *args, *idx;
+  BtorBitVector *diff;
+  BtorBitVectorPtrStack indices;
+  BtorPtrHashTableIterator it;
+  BtorMemMgr *mm;
+
+  mm    = btor->mm;
+  res   = true;
+  *step = 0;
+  BTOR_INIT_STACK (mm, indices);
+  btor_iter_hashptr_init (&it, static_rho);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    args = btor_iter_hashptr_next (&it);
+    assert (btor_node_is_regular (args));
+    assert (btor_node_is_args (args));
+    idx = args->e[0];
+    if (args->arity != 1 || !btor_node_is_bv_const (idx))
+    {
+      res = false;
+      goto DONE;
+    }
+    BTOR_PUSH_STACK (indices, BTOR_CONST_GET_BITS (idx));
+  }
+
+  qsort (indices.start,
+         BTOR_COUNT_STACK (indices),
+         sizeof (BtorBitVector *),
+         compare_bv_qsort);
+
+  if (BTOR_EMPTY_STACK (indices)
+      || btor_bv_compare (BTOR_PEEK_STACK (indices, 0), lower)
+      || btor_bv_compare (BTOR_TOP_STACK (indices), upper))
+  {
+    res = false;
+    goto DONE;
+  }
+
+  for (i = 1; res && i < BTOR_COUNT_STACK (indices); i++)
+  {
+    diff = btor_bv_sub (
+        mm, BTOR_PEEK_STACK (indices, i), BTOR_PEEK_STACK (indices, i - 1));
+    if (!*step)
+      *step = diff;
+    else
+    {
+      res = btor_bv_compare (diff, *step) == 0;
+      btor_bv_free (mm, diff);
+    }
+  }
+  if (!res && *step)
+  {
+    btor_bv_free (mm, *step);
+    *step = 0;
+  }
+DONE:
+  BTOR_RELEASE_STACK (indices);
+  return res;
+}
+
+/* Check whether 'fun' is a range write (see BtorFlatStoreRange). The bounds
+ * are taken from the range condition, which may miss a bound if it was
+ * rewritten to true, and the step is derived from the static_rho of 'fun',
+ * which holds exactly the indices of the range.  If 'range' is given, it is
+ * initialized with (copies of) the bounds and the step. */
+static bool
+is_range_write (Btor *btor,
+                BtorNode *fun,
+                BtorNode **array,
+                BtorFlatStoreRange *range)
+{
+  assert (btor_node_is_regular (fun));
+
+  bool res;
+  uint32_t num_other, width;
+  BtorNode *param, *body, *cond, *app, *cur, *real, *lower, *upper;
+  BtorPtrHashTable *static_rho;
+  BtorBitVector *lo, *hi, *step;
+  BtorNodePtrStack visit;
+  BtorMemMgr *mm;
+
+  if (!btor_node_is_lambda (fun) || fun->parameterized
+      || btor_node_fun_get_arity (btor, fun) > 1
+      || !(static_rho = btor_node_lambda_get_static_rho (fun)))
+    return false;
+
+  param = fun->e[0];
+  body  = btor_node_binder_get_body (fun);
+
+  if (btor_node_is_inverted (body) || !btor_node_is_bv_cond (body))
+    return false;
+
+  /* else branch must be a read on the unmodified array, the branches may
+   * have been swapped when normalizing an inverted range condition */
+  if (is_param_read (btor, body->e[2], param))
+  {
+    cond = body->e[0];
+    app  = body->e[2];
+  }
+  else if (is_param_read (btor, body->e[1], param))
+  {
+    cond = btor_node_invert (body->e[0]);
+    app  = body->e[1];
+  }
+  else
+    return false;
+
+  /* collect bounds lower <= p (!(p < lower)) and p <= upper (!(upper < p))
+   * from the conjunction of the range condition */
+  mm        = btor->mm;
+  lower     = upper = 0;
+  num_other = 0;
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_PUSH_STACK (visit, cond);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur  = BTOR_POP_STACK (visit);
+    real = btor_node_real_addr (cur);
+    if (!btor_node_is_inverted (cur) && btor_node_is_bv_and (cur))
+    {
+      BTOR_PUSH_STACK (visit, cur->e[0]);
+      BTOR_PUSH_STACK (visit, cur->e[1]);
+      continue;
+    }
+    if (btor_node_is_inverted (cur) && btor_node_is_bv_ult (real))
+    {
+      if (!lower && real->e[0] == param && btor_node_is_bv_const (real->e[1]))
+      {
+        lower = real->e[1];
+        continue;
+      }
+      if (!upper && real->e[1] == param && btor_node_is_bv_const (real->e[0]))
+      {
+        upper = real->e[0];
+        continue;
+      }
+    }
+    num_other++;
+  }
+  BTOR_RELEASE_STACK (visit);
+
+  /* at most one additional condition for the step */
+  if (num_other > 1) return false;
+
+  width = btor_node_bv_get_width (btor, param);
+  lo = lower ? btor_bv_copy (mm, BTOR_CONST_GET_BITS (lower))
+             : btor_bv_zero (mm, width);
+  hi = upper ? btor_bv_copy (mm, BTOR_CONST_GET_BITS (upper))
+             : btor_bv_ones (mm, width);
+
+  res = btor_bv_compare (lo, hi) <= 0
+        && is_range_static_rho (btor, static_rho, lo, hi, &step);
+
+  if (res)
+  {
+    /* a step condition is only created for steps > 1 */
+    if (step && btor_bv_is_one (step))
+    {
+      btor_bv_free (mm, step);
+      step = 0;
+    }
+    if ((num_other == 1) != (step != 0))
+    {
+      res = false;
+      if (step) btor_bv_free (mm, step);
+      step = 0;
+    }
+  }
+
+  if (res && range)
+  {
+    range->lower     = lo;
+    range->upper     = hi;
+    range->step      = step;
+    range->max_upper = 0;
+    *array           = app->e[0];
+    return true;
+  }
+
+  btor_bv_free (mm, lo);
+  btor_bv_free (mm, hi);
+  if (step) btor_bv_free (mm, step);
+  if (res) *array = app->e[0];
+  return res;
+}
+
+static bool
+is_flat_write (Btor *btor, BtorNode *fun, BtorNode **array)
+{
+  BtorNode *index;
+  return is_const_write (btor, fun, array, &index)
+         || is_range_write (btor, fun, array, 0);
+}
+
+/* Compute 'max_upper' of the interval tree over 'ranges[l, r)'. */
+static BtorBitVector *
+build_range_tree (BtorFlatStoreRange *ranges, uint32_t l, uint32_t r)
+{
+  uint32_t m;
+  BtorBitVector *max, *sub;
+
+  if (l >= r) return 0;
+
+  m   = l + (r - l) / 2;
+  max = ranges[m].upper;
+  if ((sub = build_range_tree (ranges, l, m)) && btor_bv_compare (sub, max) > 0)
+    max = sub;
+  if ((sub = build_range_tree (ranges, m + 1, r))
+      && btor_bv_compare (sub, max) > 0)
+    max = sub;
+  ranges[m].max_upper = max;
+  return max;
+}
+
+static bool
+range_contains (BtorMemMgr *mm,
+                BtorFlatStoreRange *range,
+                const BtorBitVector *index)
+{
+  bool res;
+  BtorBitVector *diff, *rem;
+
+  if (btor_bv_compare (range->lower, index) > 0
+      || btor_bv_compare (range->upper, index) < 0)
+    return false;
+  if (!range->step) return true;
+
+  diff = btor_bv_sub (mm, range->upper, index);
+  rem  = btor_bv_urem (mm, diff, range->step);
+  res  = btor_bv_is_zero (rem);
+  btor_bv_free (mm, diff);
+  btor_bv_free (mm, rem);
+  return res;
+}
+
+/* Find the greatest position <= k (and > 'best') of the ranges in the
+ * interval tree over 'ranges[l, r)' that contain 'index'. */
+static int32_t
+find_range (BtorMemMgr *mm,
+            BtorFlatStoreRange *ranges,
+            uint32_t l,
+            uint32_t r,
+            const BtorBitVector *index,
+            int32_t k,
+            int32_t best)
+{
+  uint32_t m;
+
+  while (l < r)
+  {
+    m = l + (r - l) / 2;
+    /* no range in this subtree reaches 'index' */
+    if (btor_bv_compare (ranges[m].max_upper, index) < 0) break;
+    best = find_range (mm, ranges, l, m, index, k, best);
+    /* all ranges in the right subtree start after 'index' */
+    if (btor_bv_compare (ranges[m].lower, index) > 0) break;
+    if ((int32_t) ranges[m].pos <= k && (int32_t) ranges[m].pos > best
+        && range_contains (mm, &ranges[m], index))
+      best = ranges[m].pos;
+    l = m + 1;
+  }
+  return best;
+}
+
+static int32_t
+compare_range_qsort (const void *a, const void *b)
+{
+  return btor_bv_compare (((BtorFlatStoreRange *) a)->lower,
+                          ((BtorFlatStoreRange *) b)->lower);
+}
+
+static BtorFlatStore *
+get_flat_store (Btor *btor, BtorNode *fun)
+{
+  BtorHashTableData *d;
+
+  if (!btor->flat_stores) return 0;
+  d = btor_hashint_map_get (btor->flat_stores, btor_node_real_addr (fun)->id);
+  return d ? d->as_ptr : 0;
+}
+
+static void
+delete_flat_store (Btor *btor, BtorFlatStore *store)
+{
+  BtorMemMgr *mm;
+  BtorPtrHashTableIterator it;
+  BtorUIntStack *positions;
+  BtorFlatStoreRange *range;
+
+  mm = btor->mm;
+  for (range = store->ranges.start; range < store->ranges.top; range++)
+  {
+    btor_bv_free (mm, range->lower);
+    btor_bv_free (mm, range->upper);
+    if (range->step) btor_bv_free (mm, range->step);
+  }
+  BTOR_RELEASE_STACK (store->ranges);
+  btor_iter_hashptr_init (&it, store->index);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    positions = it.bucket->data.as_ptr;
+    btor_bv_free (mm, btor_iter_hashptr_next (&it));
+    BTOR_RELEASE_STACK (*positions);
+    BTOR_DELETE (mm, positions);
+  }
+  btor_hashptr_table_delete (store->index);
+  btor_hashint_map_delete (store->pos);
+  BTOR_RELEASE_STACK (store->writes);
+  BTOR_DELETE (mm, store);
+}
+
+/* Flatten the write chain starting at 'top'. The chain ends at the first
+ * node that is neither a constant-index write nor a range write or that is
+ * already part of another flattened chain. */
+static uint32_t
+flatten_chain (Btor *btor, BtorNode *top, uint32_t *num_ranges)
+{
+  assert (btor_node_is_regular (top));
+  assert (btor_node_is_fun (top));
+
+  uint32_t i, n;
+  BtorNode *cur, *array, *index;
+  BtorNodePtrStack chain;
+  BtorFlatStore *store;
+  BtorPtrHashBucket *b;
+  BtorBitVector *bits;
+  BtorUIntStack *positions;
+  BtorFlatStoreRange range;
+  BtorMemMgr *mm;
+
+  mm = btor->mm;
+  BTOR_INIT_STACK (mm, chain);
+
+  cur = top;
+  while (!get_flat_store (btor, cur) && is_flat_write (btor, cur, &array))
+  {
+    BTOR_PUSH_STACK (chain, cur);
+    cur = array;
+    assert (btor_node_is_regular (cur));
+  }
+
+  n = BTOR_COUNT_STACK (chain);
+  /* short chains are only worth flattening if they end in a flattened
+   * chain, which would otherwise not be reachable in constant time */
+  if (n == 0
+      || (n < BTOR_FLAT_STORE_MIN_WRITES && !get_flat_store (btor, cur)))
+  {
+    BTOR_RELEASE_STACK (chain);
+    return 0;
+  }
+
+  BTOR_CNEW (mm, store);
+  store->top_id = top->id;
+  store->base   = cur;
+  store->pos    = btor_hashint_map_new (mm);
+  store->index  = btor_hashptr_table_new (
+      mm, (BtorHashPtr) btor_bv_hash, (BtorCmpPtr) btor_bv_compare);
+  BTOR_INIT_STACK (mm, store->writes);
+  BTOR_INIT_STACK (mm, store->ranges);
+
+  if (!btor->flat_stores) btor->flat_stores = btor_hashint_map_new (mm);
+
+  for (i = 0; i < n; i++)
+  {
+    cur = BTOR_PEEK_STACK (chain, n - 1 - i);
+    BTOR_PUSH_STACK (store->writes, cur);
+    btor_hashint_map_add (store->pos, cur->id)->as_int = i;
+    btor_hashint_map_add (btor->flat_stores, cur->id)->as_ptr = store;
+
+    if (!is_const_write (btor, cur, &array, &index))
+    {
+      (void) is_range_write (btor, cur, &array, &range);
+      range.pos = i;
+      BTOR_PUSH_STACK (store->ranges, range);
+      continue;
+    }
+
+    bits = BTOR_CONST_GET_BITS (index);
+    if (!(b = btor_hashptr_table_get (store->index, bits)))
+    {
+      BTOR_NEW (mm, positions);
+      BTOR_INIT_STACK (mm, *positions);
+      b = btor_hashptr_table_add (store->index, btor_bv_copy (mm, bits));
+      b->data.as_ptr = positions;
+    }
+    positions = b->data.as_ptr;
+    BTOR_PUSH_STACK (*positions, i);
+  }
+  BTOR_RELEASE_STACK (chain);
+
+  if (!BTOR_EMPTY_STACK (store->ranges))
+  {
+    qsort (store->ranges.start,
+           BTOR_COUNT_STACK (store->ranges),
+           sizeof (BtorFlatStoreRange),
+           compare_range_qsort);
+    (void) build_range_tree (
+        store->ranges.start, 0, BTOR_COUNT_STACK (store->ranges));
+    *num_ranges += BTOR_COUNT_STACK (store->ranges);
+  }
+  return n;
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_flatten_stores (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, num_stores = 0, num_writes = 0, num_ranges = 0, n;
+  double start, delta;
+  BtorNode *cur;
+  BtorNodePtrStack visit, tops;
+  BtorIntHashTable *cache;
+  BtorPtrHashTableIterator it;
+  BtorMemMgr *mm;
+
+  btor_delete_flat_stores (btor);
+
+  if (btor->lambdas->count == 0 && btor->ufs->count == 0) return;
+
+  start = btor_util_time_stamp ();
+  mm    = btor->mm;
+  cache = btor_hashint_table_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_INIT_STACK (mm, tops);
+
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (visit, btor_iter_hashptr_next (&it));
+
+  /* collect arrays that are read or selected via function conditionals, only
+   * these are possible entry points for propagation */
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    btor_hashint_table_add (cache, cur->id);
+
+    if (!cur->parameterized)
+    {
+      if (btor_node_is_apply (cur))
+        BTOR_PUSH_STACK (tops, cur->e[0]);
+      else if (btor_node_is_fun_cond (cur))
+      {
+        BTOR_PUSH_STACK (tops, cur->e[1]);
+        BTOR_PUSH_STACK (tops, cur->e[2]);
+      }
+    }
+
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+
+  /* flatten chains top-down such that writes in the middle of a chain that
+   * are read, too, become part of the chain above rather than splitting it up
+   * into several short chains */
+  qsort (tops.start,
+         BTOR_COUNT_STACK (tops),
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_desc);
+
+  for (i = 0; i < BTOR_COUNT_STACK (tops); i++)
+  {
+    cur = BTOR_PEEK_STACK (tops, i);
+    assert (btor_node_is_regular (cur));
+    if (get_flat_store (btor, cur)) continue;
+    if ((n = flatten_chain (btor, cur, &num_ranges)))
+    {
+      num_stores++;
+      num_writes += n;
+    }
+  }
+
+  BTOR_RELEASE_STACK (tops);
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (cache);
+
+  btor->stats.flat_stores += num_stores;
+  btor->stats.flat_store_writes += num_writes;
+  btor->stats.flat_store_ranges += num_ranges;
+  delta = btor_util_time_stamp () - start;
+  btor->time.flatstore += delta;
+  BTOR_MSG (btor->msg,
+            1,
+            "flattened %u write chains (%u writes, %u ranges) in %.3f seconds",
+            num_stores,
+            num_writes,
+            num_ranges,
+            delta);
+}
+
+void
+btor_delete_flat_stores (Btor *btor)
+{
+  assert (btor);
+
+  BtorIntHashTableIterator it;
+  BtorFlatStore *store;
+  int32_t id;
+
+  if (!btor->flat_stores) return;
+
+  /* each store is mapped to by all of its writes, delete it via its top */
+  btor_iter_hashint_init (&it, btor->flat_stores);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    id    = btor_iter_hashint_next (&it);
+    store = btor_hashint_map_get (btor->flat_stores, id)->as_ptr;
+    if (store->top_id == id) delete_flat_store (btor, store);
+  }
+  btor_hashint_map_delete (btor->flat_stores);
+  btor->flat_stores = 0;
+}
+
+bool
+btor_flatstore_contains (Btor *btor, BtorNode *fun)
+{
+  assert (btor);
+  assert (fun);
+  return get_flat_store (btor, fun) != 0;
+}
+
+BtorNode *
+btor_flatstore_lookup (Btor *btor, BtorNode *fun, const BtorBitVector *index)
+{
+  assert (btor);
+  assert (fun);
+  assert (btor_node_is_regular (fun));
+  assert (btor_node_is_fun (fun));
+  assert (index);
+
+  int32_t k, lo, hi, mid, best;
+  BtorNode *cur;
+  BtorFlatStore *store;
+  BtorPtrHashBucket *b;
+  BtorUIntStack *positions;
+
+  cur = fun;
+  while ((store = get_flat_store (btor, cur)))
+  {
+    assert (btor_hashint_map_contains (store->pos, cur->id));
+    k    = btor_hashint_map_get (store->pos, cur->id)->as_int;
+    best = -1;
+
+    if ((b = btor_hashptr_table_get (store->index, (BtorBitVector *) index)))
+    {
+      /* find greatest position <= k */
+      positions = b->data.as_ptr;
+      lo        = 0;
+      hi        = BTOR_COUNT_STACK (*positions) - 1;
+      while (lo <= hi)
+      {
+        mid = lo + (hi - lo) / 2;
+        if ((int32_t) BTOR_PEEK_STACK (*positions, mid) <= k)
+          lo = mid + 1;
+        else
+          hi = mid - 1;
+      }
+      if (hi >= 0) best = BTOR_PEEK_STACK (*positions, hi);
+    }
+
+    if (!BTOR_EMPTY_STACK (store->ranges))
+      best = find_range (btor->mm,
+                         store->ranges.start,
+                         0,
+                         BTOR_COUNT_STACK (store->ranges),
+                         index,
+                         k,
+                         best);
+
+    if (best >= 0) return BTOR_PEEK_STACK (store->writes, best);
+    cur = store->base;
+  }
+  return cur == fun ? 0 : cur;
+}
@@ -0,0 +1,42 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 Mathias Preiner.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORFLATSTORE_H_INCLUDED
+#define BTORFLATSTORE_H_INCLUDED
+
+#include <stdbool.h>
+
+#include "btorbv.h"
+#include "btortypes.h"
+
+/* Minimum number of writes a chain must have to get flattened. */
+#define BTOR_FLAT_STORE_MIN_WRITES 8
+
+/* Build flat array stores for all chains of constant-index writes (update
+ * nodes or write lambdas) and range writes (memset, index to index and
+ * memcpy lambdas with constant bounds created by extracting lambdas) that are
+ * reachable via applies. Each chain gets an index hash table that maps index
+ * values to the positions of the writes in the chain and an interval tree
+ * over its ranges, which allows to determine the write that defines the value
+ * at a constant index without traversing the chain. */
+void btor_flatten_stores (Btor *btor);
+
+/* Delete all flat array stores. */
+void btor_delete_flat_stores (Btor *btor);
+
+/* Check whether 'fun' is a write of a flattened write chain. */
+bool btor_flatstore_contains (Btor *btor, BtorNode *fun);
+
+/* Get the top-most write in the chain below (and including) 'fun' that writes
+ * to 'index' (either a constant-index write or a range write). If no such write exists, the array at the bottom of the chain is
+ * returned. Returns 0 if 'fun' is not part of a flattened write chain. */
+BtorNode *btor_flatstore_lookup (Btor *btor,
+                                 BtorNode *fun,
+                                 const BtorBitVector *index);
+
+#endif
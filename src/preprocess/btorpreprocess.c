@@ -17,11 +17,14 @@
 #include "btorlog.h"
 #include "btorsubst.h"
 #include "preprocess/btorack.h"
+#include "preprocess/btorbvdomains.h"
+#include "preprocess/btorbvwidth.h"
 #include "preprocess/btorder.h"
 #include "preprocess/btorelimapplies.h"
 #include "preprocess/btorelimslices.h"
 #include "preprocess/btorembed.h"
 #include "preprocess/btorextract.h"
+#include "preprocess/btorflatstore.h"
 #include "preprocess/btormerge.h"
 #include "preprocess/btornormadd.h"
 #include "preprocess/btorunconstrained.h"
@@ -33,21 +36,241 @@
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+#include <string.h>
+
+/*------------------------------------------------------------------------*/
+
+struct BtorPPPassInfo
+{
+  const char *name;
+  /* requires that all variable substitutions and embedded constraints have
+   * been processed, else the current round is restarted */
+  bool substituted;
+  /* maximum number of runs per call to btor_simplify (0: unlimited) */
+  uint32_t max_runs;
+};
+typedef struct BtorPPPassInfo BtorPPPassInfo;
+
+/* indexed by BtorPPPass */
+static const BtorPPPassInfo s_pp_passes[BTOR_PP_NUM_PASSES] = {
+    {"varsubst", false, 0},
+    {"embed", false, 0},
+    {"elimslices", true, 0},
+    {"bvdomains", true, 0},
+    {"skel", true, 1},
+    {"uc", true, 0},
+    {"extract", true, 0},
+    {"merge", true, 0},
+    {"elimapplies", true, 0},
+    {"ack", false, 0},
+    {"normadds", false, 0},
+    {"bvwidths", false, 0},
+};
+
+bool
+btor_pp_parse_pipeline (BtorMemMgr *mm,
+                        const char *pipeline,
+                        BtorIntStack *passes)
+{
+  assert (mm);
+  assert (pipeline);
+
+  bool res;
+  char *str, *tok;
+  int32_t pass;
+
+  res = true;
+  str = btor_mem_strdup (mm, pipeline);
+  for (tok = strtok (str, ","); tok; tok = strtok (0, ","))
+  {
+    for (pass = 0; pass < BTOR_PP_NUM_PASSES; pass++)
+      if (!strcmp (tok, s_pp_passes[pass].name)) break;
+    if (pass == BTOR_PP_NUM_PASSES)
+    {
+      res = false;
+      break;
+    }
+    if (passes) BTOR_PUSH_STACK (*passes, pass);
+  }
+  btor_mem_freestr (mm, str);
+  return res;
+}
+
+static bool
+is_enabled_pass (Btor *btor, BtorPPPass pass)
+{
+  uint32_t rwl;
+
+  rwl = btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL);
+  switch (pass)
+  {
+    case BTOR_PP_PASS_VAR_SUBST:
+      return rwl > 1 && btor_opt_get (btor, BTOR_OPT_VAR_SUBST);
+    case BTOR_PP_PASS_EMBED: return rwl > 1;
+    case BTOR_PP_PASS_ELIM_SLICES:
+      return rwl > 2 && btor_opt_get (btor, BTOR_OPT_ELIMINATE_SLICES)
+             && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL);
+    case BTOR_PP_PASS_BV_DOMAINS:
+      return rwl > 2 && btor_opt_get (btor, BTOR_OPT_SIMP_BV_DOMAINS)
+             && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+             && btor->quantifiers->count == 0;
+    case BTOR_PP_PASS_SKEL:
+#ifndef BTOR_DO_NOT_PROCESS_SKELETON
+      return rwl > 2 && btor_opt_get (btor, BTOR_OPT_SKELETON_PREPROC);
+#else
+      return false;
+#endif
+    case BTOR_PP_PASS_UCOPT:
+      return rwl > 2 && btor_opt_get (btor, BTOR_OPT_UCOPT)
+             && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+             && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN);
+    case BTOR_PP_PASS_EXTRACT:
+      return rwl > 2 && btor_opt_get (btor, BTOR_OPT_EXTRACT_LAMBDAS);
+    case BTOR_PP_PASS_MERGE:
+      return rwl > 2 && btor_opt_get (btor, BTOR_OPT_MERGE_LAMBDAS);
+    case BTOR_PP_PASS_ELIM_APPLIES:
+      return btor_opt_get (btor, BTOR_OPT_BETA_REDUCE);
+    case BTOR_PP_PASS_ACK: return btor_opt_get (btor, BTOR_OPT_ACKERMANN);
+    case BTOR_PP_PASS_NORM_ADDS:
+      return rwl > 2 && btor_opt_get (btor, BTOR_OPT_SIMP_NORMAMLIZE_ADDERS);
+    default:
+      assert (pass == BTOR_PP_PASS_BV_WIDTHS);
+      return rwl > 2 && btor_opt_get (btor, BTOR_OPT_SIMP_BV_WIDTHS);
+  }
+}
+
+static void
+run_pass (Btor *btor, BtorPPPass pass)
+{
+  switch (pass)
+  {
+    case BTOR_PP_PASS_VAR_SUBST: btor_substitute_var_exps (btor); break;
+
+    case BTOR_PP_PASS_EMBED:
+      while (btor->embedded_constraints->count && !btor->inconsistent)
+        btor_process_embedded_constraints (btor);
+      break;
+
+    case BTOR_PP_PASS_ELIM_SLICES:
+      btor_eliminate_slices_on_bv_vars (btor);
+      break;
+
+    case BTOR_PP_PASS_BV_DOMAINS: btor_process_bv_domains (btor); break;
+
+    case BTOR_PP_PASS_SKEL:
+#ifndef BTOR_DO_NOT_PROCESS_SKELETON
+      btor_process_skeleton (btor);
+#endif
+      break;
+
+    case BTOR_PP_PASS_UCOPT: btor_optimize_unconstrained (btor); break;
+
+    case BTOR_PP_PASS_EXTRACT: btor_extract_lambdas (btor); break;
+
+    case BTOR_PP_PASS_MERGE: btor_merge_lambdas (btor); break;
+
+    /* rewrite/beta-reduce applies on lambdas */
+    case BTOR_PP_PASS_ELIM_APPLIES:
+      /* If no UFs or function equalities are present, we eagerly eliminate all
+       * remaining lambdas. */
+      if (btor->ufs->count == 0 && btor->feqs->count == 0
+          && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+      {
+        BTOR_MSG (btor->msg,
+                  1,
+                  "no UFs or function equalities, enable beta-reduction=all");
+        btor_opt_set (btor, BTOR_OPT_BETA_REDUCE, BTOR_BETA_REDUCE_ALL);
+      }
+      btor_eliminate_applies (btor);
+      break;
+
+    /* add ackermann constraints for all uninterpreted functions */
+    case BTOR_PP_PASS_ACK: btor_add_ackermann_constraints (btor); break;
+
+    case BTOR_PP_PASS_NORM_ADDS: btor_normalize_adds (btor); break;
+
+    default:
+      assert (pass == BTOR_PP_PASS_BV_WIDTHS);
+      btor_reduce_bv_widths (btor);
+  }
+}
+
+/* Check if there are variable substitution or embedded constraints left that
+ * are processed by an enabled pass of 'pipeline'. */
+static bool
+has_pending_constraints (Btor *btor, BtorIntStack *pipeline)
+{
+  bool varsubst, embed;
+  uint32_t i;
+  BtorPPPass pass;
+
+  varsubst = btor->varsubst_constraints->count > 0;
+  embed    = btor->embedded_constraints->count > 0;
+  if (!varsubst && !embed) return false;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*pipeline); i++)
+  {
+    pass = BTOR_PEEK_STACK (*pipeline, i);
+    if (((varsubst && pass == BTOR_PP_PASS_VAR_SUBST)
+         || (embed && pass == BTOR_PP_PASS_EMBED))
+        && is_enabled_pass (btor, pass))
+      return true;
+  }
+  return false;
+}
+
+void
+btor_pp_print_stats (Btor *btor)
+{
+  assert (btor);
+
+  BtorPPPass pass;
+
+  BTOR_MSG (btor->msg, 1, "preprocessing passes:");
+  for (pass = 0; pass < BTOR_PP_NUM_PASSES; pass++)
+  {
+    if (!btor->stats.pp_passes[pass].runs) continue;
+    BTOR_MSG (btor->msg,
+              1,
+              "  %-11s %5u runs %8.2f seconds %10lld -> %lld nodes",
+              s_pp_passes[pass].name,
+              btor->stats.pp_passes[pass].runs,
+              btor->time.pp_passes[pass],
+              btor->stats.pp_passes[pass].nodes_before,
+              btor->stats.pp_passes[pass].nodes_after);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
 int32_t
 btor_simplify (Btor *btor)
 {
   assert (btor);
 
   BtorSolverResult result;
-  uint32_t rounds;
-  double start, delta;
-#ifndef BTOR_DO_NOT_PROCESS_SKELETON
-  uint32_t skelrounds = 0;
-#endif
+  uint32_t i, rounds, before, after, runs[BTOR_PP_NUM_PASSES] = {0};
+  double start, delta, pass_start;
+  const char *str;
+  BtorIntStack pipeline;
+  BtorPPPass pass;
 
   rounds = 0;
   start  = btor_util_time_stamp ();
 
+  BTOR_INIT_STACK (btor->mm, pipeline);
+  str = btor_opt_get_valstr (btor, BTOR_OPT_PP_PIPELINE);
+  if (!str || !btor_pp_parse_pipeline (btor->mm, str, &pipeline))
+  {
+    assert (!str);
+    BTOR_RESET_STACK (pipeline);
+    for (pass = 0; pass < BTOR_PP_NUM_PASSES; pass++)
+      BTOR_PUSH_STACK (pipeline, pass);
+  }
+
+  /* flat stores refer to nodes that may get rewritten below */
+  btor_delete_flat_stores (btor);
+
   if (btor->valid_assignments) btor_reset_incremental_usage (btor);
 
   if (btor->inconsistent) goto DONE;
@@ -74,132 +297,56 @@ btor_simplify (Btor *btor)
     assert (btor_dbg_check_all_hash_tables_proxy_free (btor));
     assert (btor_dbg_check_all_hash_tables_simp_free (btor));
     assert (btor_dbg_check_unique_table_children_proxy_free (btor));
-    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 1)
-    {
-      if (btor_opt_get (btor, BTOR_OPT_VAR_SUBST))
-      {
-        btor_substitute_var_exps (btor);
 
-        if (btor->inconsistent)
-        {
-          BTORLOG (1, "formula inconsistent after variable substitution");
-          break;
-        }
-
-        if (btor->varsubst_constraints->count)
-          break;  // TODO (ma): continue instead of break?
-      }
-
-      while (btor->embedded_constraints->count)
-      {
-        btor_process_embedded_constraints (btor);
-
-        if (btor->inconsistent)
-        {
-          BTORLOG (1,
-                   "formula inconsistent after embedded constraint processing");
-          break;
-        }
-      }
-
-      if (btor->varsubst_constraints->count) continue;
-    }
-
-    if (btor_opt_get (btor, BTOR_OPT_ELIMINATE_SLICES)
-        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+    for (i = 0; i < BTOR_COUNT_STACK (pipeline); i++)
     {
-      btor_eliminate_slices_on_bv_vars (btor);
-      if (btor->inconsistent)
-      {
-        BTORLOG (1, "formula inconsistent after slice elimination");
+      pass = BTOR_PEEK_STACK (pipeline, i);
+      if (!is_enabled_pass (btor, pass)) continue;
+
+      if (s_pp_passes[pass].substituted
+          && has_pending_constraints (btor, &pipeline))
         break;
-      }
 
-      if (btor->varsubst_constraints->count
-          || btor->embedded_constraints->count)
+      if (s_pp_passes[pass].max_runs
+          && runs[pass] >= s_pp_passes[pass].max_runs)
         continue;
-    }
+      runs[pass] += 1;
 
-#ifndef BTOR_DO_NOT_PROCESS_SKELETON
-    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && btor_opt_get (btor, BTOR_OPT_SKELETON_PREPROC))
-    {
-      skelrounds++;
-      if (skelrounds <= 1)  // TODO only one?
-      {
-        btor_process_skeleton (btor);
-        if (btor->inconsistent)
-        {
-          BTORLOG (1, "formula inconsistent after skeleton preprocessing");
-          break;
-        }
-      }
-
-      if (btor->varsubst_constraints->count
-          || btor->embedded_constraints->count)
-        continue;
-    }
-#endif
+      before     = btor->nodes_unique_table.num_elements;
+      pass_start = btor_util_time_stamp ();
+      run_pass (btor, pass);
+      delta = btor_util_time_stamp () - pass_start;
+      after = btor->nodes_unique_table.num_elements;
 
-    if (btor->varsubst_constraints->count || btor->embedded_constraints->count)
-      continue;
+      btor->time.pp_passes[pass] += delta;
+      btor->stats.pp_passes[pass].runs += 1;
+      btor->stats.pp_passes[pass].nodes_before += before;
+      btor->stats.pp_passes[pass].nodes_after += after;
+      BTOR_MSG (btor->msg,
+                2,
+                "%s: %u -> %u nodes in %.3f seconds",
+                s_pp_passes[pass].name,
+                before,
+                after,
+                delta);
 
-    if (btor_opt_get (btor, BTOR_OPT_UCOPT)
-        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
-        && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
-    {
-      btor_optimize_unconstrained (btor);
       if (btor->inconsistent)
       {
-        BTORLOG (1, "formula inconsistent after skeleton preprocessing");
-        break;
+        BTORLOG (1, "formula inconsistent after %s", s_pp_passes[pass].name);
+        goto FLATTEN;
       }
-    }
-
-    if (btor->varsubst_constraints->count || btor->embedded_constraints->count)
-      continue;
 
-    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && btor_opt_get (btor, BTOR_OPT_EXTRACT_LAMBDAS))
-      btor_extract_lambdas (btor);
-
-    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && btor_opt_get (btor, BTOR_OPT_MERGE_LAMBDAS))
-      btor_merge_lambdas (btor);
-
-    if (btor->varsubst_constraints->count || btor->embedded_constraints->count)
-      continue;
-
-    /* rewrite/beta-reduce applies on lambdas */
-    if (btor_opt_get (btor, BTOR_OPT_BETA_REDUCE))
-    {
-      /* If no UFs or function equalities are present, we eagerly eliminate all
-       * remaining lambdas. */
-      if (btor->ufs->count == 0 && btor->feqs->count == 0
-          && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
-      {
-        BTOR_MSG (btor->msg,
-                  1,
-                  "no UFs or function equalities, enable beta-reduction=all");
-        btor_opt_set (btor, BTOR_OPT_BETA_REDUCE, BTOR_BETA_REDUCE_ALL);
-      }
-      btor_eliminate_applies (btor);
+      if (pass == BTOR_PP_PASS_VAR_SUBST && btor->varsubst_constraints->count)
+        goto FLATTEN;  // TODO (ma): continue instead of break?
     }
+  } while (has_pending_constraints (btor, &pipeline));
 
-    /* add ackermann constraints for all uninterpreted functions */
-    if (btor_opt_get (btor, BTOR_OPT_ACKERMANN))
-      btor_add_ackermann_constraints (btor);
-
-    if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && btor_opt_get (btor, BTOR_OPT_SIMP_NORMAMLIZE_ADDERS))
-      btor_normalize_adds (btor);
-
-  } while (btor->varsubst_constraints->count
-           || btor->embedded_constraints->count);
+FLATTEN:
+  if (!btor->inconsistent && btor_opt_get (btor, BTOR_OPT_FLATTEN_STORES))
+    btor_flatten_stores (btor);
 
 DONE:
+  BTOR_RELEASE_STACK (pipeline);
   delta = btor_util_time_stamp () - start;
   btor->time.simplify += delta;
   BTOR_MSG (btor->msg, 1, "%u rewriting rounds in %.1f seconds", rounds, delta);
@@ -9,9 +9,41 @@
 #ifndef BTORPREPROCESS_H_INCLUDED
 #define BTORPREPROCESS_H_INCLUDED
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "btortypes.h"
+#include "utils/btormem.h"
+#include "utils/btorstack.h"
+
+/* Preprocessing passes in their default pipeline order. */
+enum BtorPPPass
+{
+  BTOR_PP_PASS_VAR_SUBST,
+  BTOR_PP_PASS_EMBED,
+  BTOR_PP_PASS_ELIM_SLICES,
+  BTOR_PP_PASS_BV_DOMAINS,
+  BTOR_PP_PASS_SKEL,
+  BTOR_PP_PASS_UCOPT,
+  BTOR_PP_PASS_EXTRACT,
+  BTOR_PP_PASS_MERGE,
+  BTOR_PP_PASS_ELIM_APPLIES,
+  BTOR_PP_PASS_ACK,
+  BTOR_PP_PASS_NORM_ADDS,
+  BTOR_PP_PASS_BV_WIDTHS,
+  BTOR_PP_NUM_PASSES,
+};
+typedef enum BtorPPPass BtorPPPass;
+
+/* Parse comma separated list of pass names 'pipeline' and push the
+ * corresponding passes onto 'passes' (if non-null).
+ * Returns false if 'pipeline' contains an invalid pass name. */
+bool btor_pp_parse_pipeline (BtorMemMgr *mm,
+                             const char *pipeline,
+                             BtorIntStack *passes);
+
+/* Print per-pass statistics (runs, time, nodes before and after). */
+void btor_pp_print_stats (Btor *btor);
 
 int32_t btor_simplify (Btor* btor);
 
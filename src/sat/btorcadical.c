@@ -69,6 +69,12 @@ failed (BtorSATMgr *smgr, int32_t lit)
   return ccadical_failed (smgr->solver, lit);
 }
 
+static void
+phase (BtorSATMgr *smgr, int32_t lit)
+{
+  ccadical_phase (smgr->solver, lit);
+}
+
 static void
 reset (BtorSATMgr *smgr)
 {
@@ -79,7 +85,7 @@ reset (BtorSATMgr *smgr)
 static int32_t
 sat (BtorSATMgr *smgr, int32_t limit)
 {
-  (void) limit;
+  if (limit >= 0) ccadical_limit (smgr->solver, "conflicts", limit);
   return ccadical_sat (smgr->solver);
 }
 
@@ -133,6 +139,7 @@ btor_sat_enable_cadical (BtorSATMgr *smgr)
   smgr->api.inc_max_var      = 0;
   smgr->api.init             = init;
   smgr->api.melt             = 0;
+  smgr->api.phase            = phase;
   smgr->api.repr             = 0;
   smgr->api.reset            = reset;
   smgr->api.sat              = sat;
@@ -125,6 +125,12 @@ class BtorMiniSAT : public SimpSolver
     return res;
   }
 
+  void phase (int32_t lit)
+  {
+    /* MiniSat's user polarity denotes the sign of the decision literal */
+    setPolarity (var (import (lit)), lbool (lit < 0));
+  }
+
   int32_t deref (int32_t lit)
   {
     if (nomodel) return fixed (lit);
@@ -203,6 +209,13 @@ failed (BtorSATMgr* smgr, int32_t lit)
   return solver->failed (lit);
 }
 
+static void
+phase (BtorSATMgr* smgr, int32_t lit)
+{
+  BtorMiniSAT* solver = (BtorMiniSAT*) smgr->solver;
+  solver->phase (lit);
+}
+
 static void
 enable_verbosity (BtorSATMgr* smgr, int32_t level)
 {
@@ -249,6 +262,7 @@ btor_sat_enable_minisat (BtorSATMgr* smgr)
   smgr->api.fixed            = fixed;
   smgr->api.inc_max_var      = inc_max_var;
   smgr->api.init             = init;
+  smgr->api.phase            = phase;
   smgr->api.repr             = 0;
   smgr->api.reset            = reset;
   smgr->api.sat              = sat;
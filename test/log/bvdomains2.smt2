@@ -0,0 +1,14 @@
+(set-logic QF_BV)
+(declare-fun x () (_ BitVec 64))
+(declare-fun y () (_ BitVec 64))
+(declare-fun z () (_ BitVec 64))
+(declare-fun w () (_ BitVec 64))
+(assert (bvult y (_ bv1000 64)))
+(assert (bvult x y))
+(assert (= (bvand z #xffffffffffff0000) #x0000000000000000))
+(assert (bvult w (bvadd x z)))
+(assert (= (bvmul (bvadd x w) (bvadd y z)) (_ bv123456 64)))
+(assert (bvult (bvudiv z (_ bv3 64)) (_ bv80000 64)))
+(assert (bvugt (bvadd x y) (_ bv2000 64)))
+(check-sat)
+(exit)
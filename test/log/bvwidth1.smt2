@@ -0,0 +1,6 @@
+(set-logic QF_BV)
+(declare-fun c () (_ BitVec 16))
+(declare-fun d () (_ BitVec 16))
+(assert (= (bvmul ((_ sign_extend 48) c) ((_ sign_extend 48) d)) (bvneg (_ bv1234567 64))))
+(check-sat)
+(exit)
@@ -0,0 +1,10 @@
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 8))
+(declare-fun b () (_ BitVec 8))
+(declare-fun c () (_ BitVec 16))
+(define-fun za () (_ BitVec 64) ((_ zero_extend 56) a))
+(define-fun zb () (_ BitVec 64) ((_ zero_extend 56) b))
+(define-fun sc () (_ BitVec 64) ((_ sign_extend 48) c))
+(assert (= (bvmul (bvadd za zb) (bvadd sc (_ bv1 64))) (_ bv4294967296 64)))
+(check-sat)
+(exit)
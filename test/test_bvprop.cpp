@@ -0,0 +1,167 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2018-2019 Aina Niemetz.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorbv.h"
+#include "btorbvprop.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btoropt.h"
+}
+
+class TestBvProp : public TestBtor
+{
+ protected:
+  static constexpr uint32_t TEST_BVPROP_BW = 8;
+
+  void SetUp () override
+  {
+    TestBtor::SetUp ();
+    btor_opt_set (d_btor, BTOR_OPT_REWRITE_LEVEL, 0);
+    d_mm   = d_btor->mm;
+    d_sort = btor_sort_bv (d_btor, TEST_BVPROP_BW);
+    d_x    = btor_exp_var (d_btor, d_sort, "x");
+  }
+
+  void TearDown () override
+  {
+    if (d_domains) btor_bvprop_delete_domains (d_btor, d_domains);
+    btor_node_release (d_btor, d_x);
+    btor_sort_release (d_btor, d_sort);
+    TestBtor::TearDown ();
+  }
+
+  BtorNode *constd (uint64_t value)
+  {
+    BtorBitVector *bv;
+    BtorNode *res;
+
+    bv  = btor_bv_uint64_to_bv (d_mm, value, TEST_BVPROP_BW);
+    res = btor_exp_bv_const (d_btor, bv);
+    btor_bv_free (d_mm, bv);
+    return res;
+  }
+
+  /* create 'exp op value' */
+  BtorNode *binop (BtorNode *(*op) (Btor *, BtorNode *, BtorNode *),
+                   BtorNode *exp,
+                   uint64_t value)
+  {
+    BtorNode *c, *res;
+
+    c   = constd (value);
+    res = op (d_btor, exp, c);
+    btor_node_release (d_btor, c);
+    return res;
+  }
+
+  /* assert 'lhs = rhs', releases 'lhs' and 'rhs' */
+  void assert_eq (BtorNode *lhs, BtorNode *rhs)
+  {
+    BtorNode *eq;
+
+    eq = btor_exp_eq (d_btor, lhs, rhs);
+    btor_assert_exp (d_btor, eq);
+    btor_node_release (d_btor, eq);
+    btor_node_release (d_btor, lhs);
+    btor_node_release (d_btor, rhs);
+  }
+
+  void check_domain (BtorNode *exp, uint64_t lo, uint64_t hi)
+  {
+    BtorBvDomain *d;
+
+    ASSERT_NE (d_domains, nullptr);
+    d = btor_bvprop_get_domain (d_mm, d_domains, exp);
+    ASSERT_NE (d, nullptr);
+    ASSERT_EQ (btor_bv_to_uint64 (d->lo), lo);
+    ASSERT_EQ (btor_bv_to_uint64 (d->hi), hi);
+    btor_bvprop_free (d_mm, d);
+  }
+
+  BtorMemMgr *d_mm            = nullptr;
+  BtorSortId d_sort           = 0;
+  BtorNode *d_x               = nullptr;
+  BtorIntHashTable *d_domains = nullptr;
+};
+
+TEST_F (TestBvProp, and)
+{
+  /* x & 11110000 = 01010000 */
+  assert_eq (binop (btor_exp_bv_and, d_x, 0xf0), constd (0x50));
+  d_domains = btor_bvprop_compute_domains (d_btor, 8);
+  check_domain (d_x, 0x50, 0x5f);
+  check_domain (btor_node_invert (d_x), 0xa0, 0xaf);
+}
+
+TEST_F (TestBvProp, ult)
+{
+  BtorNode *ult;
+
+  /* x < 00010000 */
+  ult = binop (btor_exp_bv_ult, d_x, 0x10);
+  btor_assert_exp (d_btor, ult);
+  btor_node_release (d_btor, ult);
+  d_domains = btor_bvprop_compute_domains (d_btor, 8);
+  check_domain (d_x, 0x00, 0x0f);
+}
+
+TEST_F (TestBvProp, add)
+{
+  /* x + 00000001 = 00010000 */
+  assert_eq (binop (btor_exp_bv_add, d_x, 0x01), constd (0x10));
+  d_domains = btor_bvprop_compute_domains (d_btor, 8);
+  check_domain (d_x, 0x0f, 0x0f);
+}
+
+TEST_F (TestBvProp, slice)
+{
+  BtorNode *slice, *c;
+  BtorBitVector *bv;
+
+  /* x[7:4] = 1010 */
+  slice = btor_exp_bv_slice (d_btor, d_x, 7, 4);
+  bv    = btor_bv_uint64_to_bv (d_mm, 0xa, 4);
+  c     = btor_exp_bv_const (d_btor, bv);
+  btor_bv_free (d_mm, bv);
+  assert_eq (slice, c);
+  d_domains = btor_bvprop_compute_domains (d_btor, 8);
+  check_domain (d_x, 0xa0, 0xaf);
+}
+
+TEST_F (TestBvProp, inconsistent)
+{
+  /* x & 00001111 = 00000001 and x & 00001111 = 00000010 */
+  assert_eq (binop (btor_exp_bv_and, d_x, 0x0f), constd (0x01));
+  assert_eq (binop (btor_exp_bv_and, d_x, 0x0f), constd (0x02));
+  d_domains = btor_bvprop_compute_domains (d_btor, 8);
+  ASSERT_EQ (d_domains, nullptr);
+}
+
+TEST_F (TestBvProp, fix_bits)
+{
+  BtorBitVector *bv, *res;
+
+  assert_eq (binop (btor_exp_bv_and, d_x, 0xf0), constd (0x50));
+  d_domains = btor_bvprop_compute_domains (d_btor, 8);
+
+  bv  = btor_bv_uint64_to_bv (d_mm, 0xff, TEST_BVPROP_BW);
+  res = btor_bvprop_fix_bits (d_mm, d_domains, d_x, bv);
+  ASSERT_NE (res, nullptr);
+  ASSERT_EQ (btor_bv_to_uint64 (res), 0x5fu);
+  btor_bv_free (d_mm, res);
+  btor_bv_free (d_mm, bv);
+
+  /* respects domain */
+  bv  = btor_bv_uint64_to_bv (d_mm, 0x53, TEST_BVPROP_BW);
+  res = btor_bvprop_fix_bits (d_mm, d_domains, d_x, bv);
+  ASSERT_EQ (res, nullptr);
+  btor_bv_free (d_mm, bv);
+}
@@ -0,0 +1,212 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 Mathias Preiner.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+#include "btorslvfun.h"
+}
+
+class TestFlatStore : public TestBoolector
+{
+ protected:
+  static const uint32_t s_num_writes = 64;
+
+  /* Build a chain of 's_num_writes' writes to indices i % 16 with value i on
+   * top of array 'a', and check reads at constant and symbolic indices. */
+  void test_flatstore (bool lambdas, bool negate)
+  {
+    BoolectorSort si, se, sa;
+    BoolectorNode *a, *w, *tmp, *idx, *val, *rd, *eq, *x, *y, *ne;
+    uint32_t i;
+    int32_t res;
+
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_FUN_STORE_LAMBDAS, lambdas ? 1 : 0);
+
+    si = boolector_bitvec_sort (d_btor, 8);
+    se = boolector_bitvec_sort (d_btor, 8);
+    sa = boolector_array_sort (d_btor, si, se);
+
+    a = boolector_array (d_btor, sa, "a");
+    w = boolector_copy (d_btor, a);
+    for (i = 0; i < s_num_writes; i++)
+    {
+      idx = boolector_unsigned_int (d_btor, i % 16, si);
+      val = boolector_unsigned_int (d_btor, i, se);
+      tmp = boolector_write (d_btor, w, idx, val);
+      boolector_release (d_btor, idx);
+      boolector_release (d_btor, val);
+      boolector_release (d_btor, w);
+      w = tmp;
+    }
+
+    /* 51 is only stored at index 3 (all indices < 16 are overwritten) */
+    x   = boolector_var (d_btor, si, "x");
+    rd  = boolector_read (d_btor, w, x);
+    val = boolector_unsigned_int (d_btor, 16, si);
+    tmp = boolector_ult (d_btor, x, val);
+    boolector_assert (d_btor, tmp);
+    boolector_release (d_btor, tmp);
+    boolector_release (d_btor, val);
+    val = boolector_unsigned_int (d_btor, 51, se);
+    eq  = boolector_eq (d_btor, rd, val);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, val);
+    boolector_release (d_btor, rd);
+    if (negate)
+    {
+      val = boolector_unsigned_int (d_btor, 3, si);
+      ne  = boolector_ne (d_btor, x, val);
+      boolector_assert (d_btor, ne);
+      boolector_release (d_btor, ne);
+      boolector_release (d_btor, val);
+    }
+
+    /* indices >= 16 are never written, reads go through to 'a' */
+    y   = boolector_var (d_btor, si, "y");
+    val = boolector_unsigned_int (d_btor, 15, si);
+    tmp = boolector_ugt (d_btor, y, val);
+    boolector_assert (d_btor, tmp);
+    boolector_release (d_btor, tmp);
+    boolector_release (d_btor, val);
+    rd  = boolector_read (d_btor, w, y);
+    tmp = boolector_read (d_btor, a, y);
+    eq  = boolector_eq (d_btor, rd, tmp);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, tmp);
+    boolector_release (d_btor, rd);
+
+    res = boolector_sat (d_btor);
+    ASSERT_EQ (res, negate ? BOOLECTOR_UNSAT : BOOLECTOR_SAT);
+    if (!lambdas && btor_opt_get (d_btor, BTOR_OPT_FLATTEN_STORES))
+    {
+      ASSERT_GT (d_btor->stats.flat_stores, 0u);
+      ASSERT_GE (d_btor->stats.flat_store_writes, (uint32_t) s_num_writes);
+    }
+    if (!negate)
+    {
+      const char *s = boolector_bv_assignment (d_btor, x);
+      ASSERT_EQ (strcmp (s, "00000011"), 0);
+      boolector_free_bv_assignment (d_btor, s);
+    }
+
+    boolector_release (d_btor, x);
+    boolector_release (d_btor, y);
+    boolector_release (d_btor, w);
+    boolector_release (d_btor, a);
+    boolector_release_sort (d_btor, si);
+    boolector_release_sort (d_btor, se);
+    boolector_release_sort (d_btor, sa);
+  }
+
+  /* Build a memset of 7 to indices 0 to 31 (extracted as range write) with
+   * 's_num_writes' constant-index writes of distinct values (which do not
+   * form a pattern) at indices >= 128 on top and check that only reads at
+   * indices < 32 yield 7. */
+  void test_flatstore_range (bool negate)
+  {
+    BoolectorSort si, se, sa;
+    BoolectorNode *a, *w, *tmp, *idx, *val, *v, *rd, *eq, *x, *c32;
+    uint32_t i;
+    int32_t res;
+
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+
+    si = boolector_bitvec_sort (d_btor, 8);
+    se = boolector_bitvec_sort (d_btor, 8);
+    sa = boolector_array_sort (d_btor, si, se);
+
+    a   = boolector_array (d_btor, sa, "a");
+    w   = boolector_copy (d_btor, a);
+    val = boolector_unsigned_int (d_btor, 7, se);
+    for (i = 0; i < 32; i++)
+    {
+      idx = boolector_unsigned_int (d_btor, i, si);
+      tmp = boolector_write (d_btor, w, idx, val);
+      boolector_release (d_btor, idx);
+      boolector_release (d_btor, w);
+      w = tmp;
+    }
+    for (i = 0; i < s_num_writes; i++)
+    {
+      idx = boolector_unsigned_int (d_btor, 128 + i, si);
+      v   = boolector_unsigned_int (d_btor, (i * 13 + 5) % 256, se);
+      tmp = boolector_write (d_btor, w, idx, v);
+      boolector_release (d_btor, idx);
+      boolector_release (d_btor, v);
+      boolector_release (d_btor, w);
+      w = tmp;
+    }
+
+    /* a[x] != 7 && w[x] = 7 implies x < 32 */
+    x  = boolector_var (d_btor, si, "x");
+    rd = boolector_read (d_btor, w, x);
+    eq = boolector_eq (d_btor, rd, val);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, rd);
+    rd = boolector_read (d_btor, a, x);
+    eq = boolector_ne (d_btor, rd, val);
+    boolector_assert (d_btor, eq);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, rd);
+    c32 = boolector_unsigned_int (d_btor, 32, si);
+    if (negate)
+    {
+      tmp = boolector_ugte (d_btor, x, c32);
+      boolector_assert (d_btor, tmp);
+      boolector_release (d_btor, tmp);
+    }
+
+    res = boolector_sat (d_btor);
+    ASSERT_EQ (res, negate ? BOOLECTOR_UNSAT : BOOLECTOR_SAT);
+    ASSERT_GT (d_btor->stats.flat_store_ranges, 0u);
+    if (!negate)
+    {
+      const char *s;
+      tmp = boolector_ult (d_btor, x, c32);
+      s   = boolector_bv_assignment (d_btor, tmp);
+      ASSERT_EQ (strcmp (s, "1"), 0);
+      boolector_free_bv_assignment (d_btor, s);
+      boolector_release (d_btor, tmp);
+    }
+
+    boolector_release (d_btor, x);
+    boolector_release (d_btor, c32);
+    boolector_release (d_btor, val);
+    boolector_release (d_btor, w);
+    boolector_release (d_btor, a);
+    boolector_release_sort (d_btor, si);
+    boolector_release_sort (d_btor, se);
+    boolector_release_sort (d_btor, sa);
+  }
+};
+
+TEST_F (TestFlatStore, update_sat) { test_flatstore (false, false); }
+
+TEST_F (TestFlatStore, update_unsat) { test_flatstore (false, true); }
+
+TEST_F (TestFlatStore, lambda_sat) { test_flatstore (true, false); }
+
+TEST_F (TestFlatStore, lambda_unsat) { test_flatstore (true, true); }
+
+TEST_F (TestFlatStore, disabled)
+{
+  boolector_set_opt (d_btor, BTOR_OPT_FLATTEN_STORES, 0);
+  test_flatstore (false, true);
+  ASSERT_EQ (d_btor->stats.flat_stores, 0u);
+}
+
+TEST_F (TestFlatStore, range_sat) { test_flatstore_range (false); }
+
+TEST_F (TestFlatStore, range_unsat) { test_flatstore_range (true); }
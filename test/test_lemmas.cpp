@@ -0,0 +1,129 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 Mathias Preiner.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btorslvfun.h"
+}
+
+class TestLemmas : public TestBoolector
+{
+ protected:
+  static const uint32_t s_num_writes = 8;
+
+  uint32_t get_refinements (Btor *btor)
+  {
+    /* no solver is created if the formula is solved by preprocessing */
+    return btor->slv ? BTOR_FUN_SOLVER (btor)->stats.lod_refinements : 0;
+  }
+
+  /* Write 's_num_writes' symbolic values to symbolic indices of array 'a' and
+   * assert that the resulting array differs from 'a' at index 'j', which is
+   * distinct from all written indices (unsat) or all but the last (sat). */
+  void build_formula (Btor *btor, bool sat)
+  {
+    BoolectorSort si, sa;
+    BoolectorNode *a, *w, *tmp, *idx, *val, *j, *r0, *r1;
+    uint32_t i;
+    char name[16];
+
+    si = boolector_bitvec_sort (btor, 8);
+    sa = boolector_array_sort (btor, si, si);
+    a  = boolector_array (btor, sa, "a");
+    j  = boolector_var (btor, si, "j");
+    w  = boolector_copy (btor, a);
+    for (i = 0; i < s_num_writes; i++)
+    {
+      sprintf (name, "i%u", i);
+      idx = boolector_var (btor, si, name);
+      sprintf (name, "v%u", i);
+      val = boolector_var (btor, si, name);
+      tmp = boolector_write (btor, w, idx, val);
+      boolector_release (btor, w);
+      w = tmp;
+      if (!sat || i + 1 < s_num_writes)
+      {
+        tmp = boolector_ne (btor, idx, j);
+        boolector_assert (btor, tmp);
+        boolector_release (btor, tmp);
+      }
+      boolector_release (btor, idx);
+      boolector_release (btor, val);
+    }
+    r0  = boolector_read (btor, w, j);
+    r1  = boolector_read (btor, a, j);
+    tmp = boolector_ne (btor, r0, r1);
+    boolector_assert (btor, tmp);
+    boolector_release (btor, tmp);
+    boolector_release (btor, r0);
+    boolector_release (btor, r1);
+    boolector_release (btor, j);
+    boolector_release (btor, w);
+    boolector_release (btor, a);
+    boolector_release_sort (btor, sa);
+    boolector_release_sort (btor, si);
+  }
+
+  /* Solve the formula, dump the lemmas and solve it again in a fresh
+   * instance after loading the dumped lemmas. */
+  void test_lemmas (bool sat)
+  {
+    Btor *btor;
+    FILE *file;
+    char *err;
+    int32_t res, res_load, parse_res;
+    uint32_t refinements;
+
+    boolector_set_opt (d_btor, BTOR_OPT_FUN_STORE_LAMBDAS, 1);
+    build_formula (d_btor, sat);
+    res = boolector_sat (d_btor);
+    ASSERT_EQ (res, sat ? BOOLECTOR_SAT : BOOLECTOR_UNSAT);
+    refinements = get_refinements (d_btor);
+    ASSERT_GT (refinements, 0u);
+
+    file = tmpfile ();
+    ASSERT_NE (file, nullptr);
+    boolector_dump_lemmas_smt2 (d_btor, file);
+    rewind (file);
+
+    btor = boolector_new ();
+    boolector_set_opt (btor, BTOR_OPT_FUN_STORE_LAMBDAS, 1);
+    build_formula (btor, sat);
+    err       = 0;
+    parse_res = boolector_parse_lemmas_smt2 (btor, file, "lemmas", &err);
+    fclose (file);
+    ASSERT_EQ (parse_res, BOOLECTOR_PARSE_UNKNOWN);
+    ASSERT_EQ (err, nullptr);
+    res_load = boolector_sat (btor);
+    ASSERT_EQ (res_load, res);
+    ASSERT_LT (get_refinements (btor), refinements);
+    boolector_delete (btor);
+  }
+};
+
+TEST_F (TestLemmas, sat) { test_lemmas (true); }
+
+TEST_F (TestLemmas, unsat) { test_lemmas (false); }
+
+TEST_F (TestLemmas, no_lemmas)
+{
+  FILE *file;
+  char *err;
+
+  file = tmpfile ();
+  ASSERT_NE (file, nullptr);
+  boolector_dump_lemmas_smt2 (d_btor, file);
+  rewind (file);
+  err = 0;
+  ASSERT_EQ (boolector_parse_lemmas_smt2 (d_btor, file, "lemmas", &err),
+             BOOLECTOR_PARSE_UNKNOWN);
+  fclose (file);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+}
@@ -0,0 +1,105 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  Copyright (C) 2020 Mathias Preiner.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+}
+
+class TestPhase : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    d_sort = boolector_bitvec_sort (d_btor, 8);
+    d_x    = boolector_var (d_btor, d_sort, "x");
+    d_y    = boolector_var (d_btor, d_sort, "y");
+  }
+
+  void TearDown () override
+  {
+    boolector_release (d_btor, d_x);
+    boolector_release (d_btor, d_y);
+    boolector_release_sort (d_btor, d_sort);
+    TestBoolector::TearDown ();
+  }
+
+  /* x < y, x + y != 7 (not solved by preprocessing) */
+  void assert_formula ()
+  {
+    BoolectorNode *ult, *add, *c, *ne;
+
+    ult = boolector_ult (d_btor, d_x, d_y);
+    add = boolector_add (d_btor, d_x, d_y);
+    c   = boolector_unsigned_int (d_btor, 7, d_sort);
+    ne  = boolector_ne (d_btor, add, c);
+    boolector_assert (d_btor, ult);
+    boolector_assert (d_btor, ne);
+    boolector_release (d_btor, ult);
+    boolector_release (d_btor, add);
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, ne);
+  }
+
+  BoolectorSort d_sort;
+  BoolectorNode *d_x, *d_y;
+};
+
+TEST_F (TestPhase, hint)
+{
+  assert_formula ();
+  boolector_set_phase_hint (d_btor, d_x, "00101010");
+  boolector_set_phase_hint (d_btor, d_y, "11000011");
+  ASSERT_NE (d_btor->phase_hints, nullptr);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  /* hints are discarded after the SAT call */
+  ASSERT_EQ (d_btor->phase_hints, nullptr);
+  if (btor_get_sat_mgr (d_btor)->api.phase)
+  {
+    ASSERT_EQ (d_btor->stats.phase_hints, 16u);
+  }
+}
+
+TEST_F (TestPhase, incremental)
+{
+  BoolectorNode *z, *ne, *zero;
+  uint_least64_t hints;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  assert_formula ();
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  hints = d_btor->stats.phase_hints;
+
+  /* the model of x and y is passed as phase hints */
+  z    = boolector_var (d_btor, d_sort, "z");
+  zero = boolector_zero (d_btor, d_sort);
+  ne   = boolector_ne (d_btor, z, zero);
+  boolector_assume (d_btor, ne);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  if (btor_get_sat_mgr (d_btor)->api.phase)
+  {
+    ASSERT_EQ (d_btor->stats.phase_hints, hints + 16);
+  }
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, zero);
+  boolector_release (d_btor, z);
+
+  /* only the hint set by the user is passed */
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL_PHASES, 0);
+  boolector_set_phase_hint (d_btor, d_x, "00000001");
+  hints = d_btor->stats.phase_hints;
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->phase_hints, nullptr);
+  if (btor_get_sat_mgr (d_btor)->api.phase)
+  {
+    ASSERT_EQ (d_btor->stats.phase_hints, hints + 8);
+  }
+}